@@ -0,0 +1,105 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: Parallel.h
+// ========
+// Simple fork-join utilities built on std::thread.
+//
+// Last revision: 18/10/2026
+
+#ifndef __Parallel_h
+#define __Parallel_h
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace cg
+{ // begin namespace cg
+
+namespace parallel
+{ // begin namespace parallel
+
+/// Returns the number of threads used when none is specified.
+inline int
+defaultNumberOfThreads()
+{
+  auto n = (int)std::thread::hardware_concurrency();
+  return n > 0 ? n : 1;
+}
+
+/// Calls task(i), i in [0, n), each one on its own thread, and
+/// waits for all of them. Task n - 1 runs on the calling thread.
+template <typename Task>
+void
+run(int n, const Task& task)
+{
+  if (n <= 1)
+  {
+    if (n == 1)
+      task(0);
+    return;
+  }
+
+  std::vector<std::thread> threads;
+
+  threads.reserve(n - 1);
+  for (int i = 0; i < n - 1; ++i)
+    threads.emplace_back([&task, i]() { task(i); });
+  task(n - 1);
+  for (auto& thread : threads)
+    thread.join();
+}
+
+/// Splits [0, count) into at most numberOfThreads ranges of at least
+/// minRangeSize elements and calls task(begin, end) on each of them
+/// in parallel. If numberOfThreads <= 0, the default is used.
+template <typename Task>
+void
+forRange(int count, int minRangeSize, const Task& task, int numberOfThreads = 0)
+{
+  if (numberOfThreads <= 0)
+    numberOfThreads = defaultNumberOfThreads();
+
+  auto n = std::min(numberOfThreads, count / std::max(minRangeSize, 1));
+
+  if (n <= 1)
+  {
+    if (count > 0)
+      task(0, count);
+    return;
+  }
+  run(n, [&](int i)
+  {
+    task(int(int64_t(count) * i / n), int(int64_t(count) * (i + 1) / n));
+  });
+}
+
+} // end namespace parallel
+
+} // end namespace cg
+
+#endif // __Parallel_h
@@ -28,7 +28,7 @@
 // Class definition for 3D axis-aligned bounding box.
 //
 // Author: Paulo Pagliosa
-// Last revision: 05/08/2019
+// Last revision: 18/10/2026
 
 #ifndef __Bounds3_h
 #define __Bounds3_h
@@ -63,14 +63,19 @@ public:
     set(min, max);
   }
 
+  Bounds3(const Bounds3<real>&) = default;
+
+  /// Constructs the bounds of b transformed by m.
   HOST DEVICE
-  Bounds3(const Bounds3<real>& b, const mat4& m = mat4::identity()):
+  Bounds3(const Bounds3<real>& b, const mat4& m):
     _p1{b._p1},
     _p2{b._p2}
   {
     transform(m);
   }
 
+  Bounds3& operator =(const Bounds3<real>&) = default;
+
   HOST DEVICE
   vec3 center() const
   {
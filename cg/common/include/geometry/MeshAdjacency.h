@@ -0,0 +1,193 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: MeshAdjacency.h
+// ========
+// Class definition for triangle mesh adjacency.
+//
+// Last revision: 18/10/2026
+
+#ifndef __MeshAdjacency_h
+#define __MeshAdjacency_h
+
+#include "core/SharedObject.h"
+#include <vector>
+
+namespace cg
+{ // begin namespace cg
+
+
+/////////////////////////////////////////////////////////////////////
+//
+// MeshAdjacency: triangle mesh adjacency class
+// =============
+//
+// Corner c is vertex c % 3 of triangle c / 3, and the origin of the
+// half-edge c, which goes to the next corner of the triangle. The
+// corners and neighbors of the vertices are kept in compressed arrays
+// (CSR), and the twin of each half-edge in a table.
+class MeshAdjacency: public SharedObject
+{
+public:
+  /// Contiguous range of indices.
+  class Range
+  {
+  public:
+    Range(const int* begin, const int* end):
+      _begin{begin},
+      _end{end}
+    {
+      // do nothing
+    }
+
+    auto begin() const
+    {
+      return _begin;
+    }
+
+    auto end() const
+    {
+      return _end;
+    }
+
+    int size() const
+    {
+      return int(_end - _begin);
+    }
+
+    int operator [](int i) const
+    {
+      return _begin[i];
+    }
+
+  private:
+    const int* _begin;
+    const int* _end;
+
+  }; // Range
+
+  /// Builds the adjacency of the triangles whose vertex indices are
+  /// v[0..3 * numberOfTriangles), in O(n log d) time, where d is the
+  /// maximum vertex valence, using numberOfThreads threads (all the
+  /// hardware threads if numberOfThreads <= 0). The indices are not
+  /// copied and must outlive the adjacency.
+  MeshAdjacency(int numberOfVertices,
+    int numberOfTriangles,
+    const int* v,
+    int numberOfThreads = 0);
+
+  int numberOfVertices() const
+  {
+    return int(_cornerOffsets.size()) - 1;
+  }
+
+  int numberOfCorners() const
+  {
+    return int(_twins.size());
+  }
+
+  static int triangle(int c)
+  {
+    return c / 3;
+  }
+
+  static int next(int c)
+  {
+    return c % 3 == 2 ? c - 2 : c + 1;
+  }
+
+  static int previous(int c)
+  {
+    return c % 3 == 0 ? c + 2 : c - 1;
+  }
+
+  /// Returns the vertex of corner c.
+  int vertex(int c) const
+  {
+    return _v[c];
+  }
+
+  /// Returns the half-edge opposite to the half-edge c, or -1 if the
+  /// edge of c is a border or non-manifold edge.
+  int twin(int c) const
+  {
+    return _twins[c];
+  }
+
+  bool isBorder(int c) const
+  {
+    return _twins[c] < 0;
+  }
+
+  /// Returns the corners of vertex v in triangle order.
+  Range vertexCorners(int v) const
+  {
+    auto p = _vertexCorners.data();
+    return {p + _cornerOffsets[v], p + _cornerOffsets[v + 1]};
+  }
+
+  /// Returns the vertices sharing an edge with vertex v (its one-ring),
+  /// in order of first use by the triangles of v.
+  Range vertexNeighbors(int v) const
+  {
+    auto p = _neighbors.data();
+    return {p + _neighborOffsets[v], p + _neighborOffsets[v + 1]};
+  }
+
+  /// Returns true if vertex v is on a border or non-manifold edge.
+  bool isBorderVertex(int v) const;
+
+  int numberOfBorderEdges() const
+  {
+    return _borderEdges;
+  }
+
+  /// Returns the number of edges shared by more than two triangles,
+  /// or by two triangles with the same orientation.
+  int numberOfNonManifoldEdges() const
+  {
+    return _nonManifoldEdges;
+  }
+
+  bool isClosed() const
+  {
+    return _borderEdges == 0 && _nonManifoldEdges == 0;
+  }
+
+private:
+  const int* _v;
+  std::vector<int> _cornerOffsets;
+  std::vector<int> _vertexCorners;
+  std::vector<int> _neighborOffsets;
+  std::vector<int> _neighbors;
+  std::vector<int> _twins;
+  int _borderEdges;
+  int _nonManifoldEdges;
+
+}; // MeshAdjacency
+
+} // end namespace cg
+
+#endif // __MeshAdjacency_h
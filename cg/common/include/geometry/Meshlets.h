@@ -0,0 +1,151 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: Meshlets.h
+// ========
+// Class definition for triangle mesh meshlets.
+//
+// Last revision: 18/10/2026
+
+#ifndef __Meshlets_h
+#define __Meshlets_h
+
+#include "core/SharedObject.h"
+#include "geometry/Ray.h"
+#include <vector>
+
+namespace cg
+{ // begin namespace cg
+
+//
+// Forward definition
+//
+class TriangleMesh;
+
+
+/////////////////////////////////////////////////////////////////////
+//
+// Meshlets: triangle mesh meshlets class
+// ========
+//
+// Partition of the triangles of a mesh into small clusters of adjacent
+// triangles (meshlets) whose bounding spheres and normal cones allow
+// culling the parts of the mesh out of the view or back facing.
+class Meshlets: public SharedObject
+{
+public:
+  static constexpr int maxVertices = 64;
+  static constexpr int maxTriangles = 124;
+
+  struct Meshlet
+  {
+    // Range of triangles of the mesh
+    int firstTriangle;
+    int triangleCount;
+    // Range of vertex indices in vertices()
+    int firstVertex;
+    int vertexCount;
+    // Bounding sphere
+    vec3f center;
+    float radius;
+    // The triangle normals make an angle of at most asin(coneCutoff)
+    // with coneAxis (coneCutoff is 1 if the cone is too wide to cull)
+    vec3f coneAxis;
+    float coneCutoff;
+
+    /// Returns true if ray may hit a triangle of this meshlet.
+    bool intersects(const Ray& ray) const;
+
+  }; // Meshlet
+
+  /// Splits the triangles of mesh into meshlets of at most maxVertices
+  /// vertices and maxTriangles triangles, built greedily by adding the
+  /// adjacent triangle with the fewest new vertices nearest to the
+  /// meshlet. The triangles of mesh are reordered so that those of a
+  /// meshlet are contiguous, and those within a meshlet are then put in
+  /// vertex cache order (see MeshOptimizer::optimizeVertexCache()). New
+  /// meshlets start next to the previous one or at the first triangle
+  /// left in input order, so the order of the meshlets roughly follows
+  /// the input order. The meshlets are also set to mesh.
+  static Meshlets* build(TriangleMesh& mesh);
+
+  int size() const
+  {
+    return int(_meshlets.size());
+  }
+
+  const Meshlet& operator [](int i) const
+  {
+    return _meshlets[i];
+  }
+
+  auto begin() const
+  {
+    return _meshlets.begin();
+  }
+
+  auto end() const
+  {
+    return _meshlets.end();
+  }
+
+  /// Returns the indices of the vertices of the meshlets.
+  const std::vector<int>& vertices() const
+  {
+    return _vertices;
+  }
+
+  /// Transforms the bounding spheres and normal cones by trs (e.g.,
+  /// after TriangleMesh::TRS()) and returns true if trs is a similarity,
+  /// i.e., a rotation, uniform scale, reflection and translation;
+  /// otherwise, returns false and leaves the meshlets unchanged.
+  bool transform(const mat4f& trs);
+
+  /// Appends to visible the indices of the meshlets intersecting the
+  /// view volume of the clip matrix (projection * view * model).
+  void cull(const mat4f& clip, std::vector<int>& visible) const;
+
+  /// Same as above, but also culls the meshlets entirely back facing
+  /// the eye, given in model coordinates as a point (w = 1) for a
+  /// perspective projection, or as the direction toward the viewer
+  /// (w = 0) for a parallel projection. Use it only if the back faces
+  /// are not drawn anyway (e.g., with GL_CULL_FACE enabled).
+  void cull(const mat4f& clip,
+    const vec4f& eye,
+    std::vector<int>& visible) const;
+
+private:
+  std::vector<Meshlet> _meshlets;
+  std::vector<int> _vertices;
+
+  Meshlets() = default;
+
+  friend class MeshCache;
+
+}; // Meshlets
+
+} // end namespace cg
+
+#endif // __Meshlets_h
@@ -0,0 +1,163 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: QuantizedMesh.h
+// ========
+// Class definition for quantized triangle mesh.
+//
+// Last revision: 18/10/2026
+
+#ifndef __QuantizedMesh_h
+#define __QuantizedMesh_h
+
+#include "geometry/TriangleMesh.h"
+#include <cstdint>
+
+namespace cg
+{ // begin namespace cg
+
+
+/////////////////////////////////////////////////////////////////////
+//
+// QuantizedMesh: quantized triangle mesh class
+// =============
+//
+// Compressed copy of the vertex attributes and triangles of a mesh:
+// positions quantized to 16 bits relative to the mesh bounds, normals
+// (if any) octahedral-encoded to 2x16 or 2x8 bits, uv (if any) as half
+// floats, and 16-bit
+// indices when the mesh has at most 65536 vertices.
+class QuantizedMesh: public SharedObject
+{
+public:
+  /// Quantizes mesh, encoding the normals with normalBits (16 or 8)
+  /// bits per component.
+  QuantizedMesh(const TriangleMesh& mesh, int normalBits = 16);
+
+  int numberOfVertices() const
+  {
+    return _numberOfVertices;
+  }
+
+  int numberOfTriangles() const
+  {
+    return _numberOfTriangles;
+  }
+
+  /// Returns the bounds the positions are quantized relative to.
+  const Bounds3f& bounds() const
+  {
+    return _bounds;
+  }
+
+  /// Returns the matrix mapping the positions, normalized to [0,1],
+  /// to the positions of the mesh.
+  mat4f positionMatrix() const;
+
+  /// Returns the quantized positions, four 16-bit unsigned integers
+  /// per vertex (the fourth is padding, for 4-byte alignment).
+  const uint16_t* positions() const
+  {
+    return _positions.data();
+  }
+
+  int normalBits() const
+  {
+    return _normalBits;
+  }
+
+  /// Returns true if the mesh has vertex normals (otherwise, they are
+  /// not encoded).
+  bool hasNormals() const
+  {
+    return !_normals.empty();
+  }
+
+  /// Returns the octahedral-encoded normals, two signed integers of
+  /// normalBits bits per vertex (null if none).
+  const void* normals() const
+  {
+    return hasNormals() ? _normals.data() : nullptr;
+  }
+
+  bool hasUV() const
+  {
+    return !_uv.empty();
+  }
+
+  /// Returns the uv, two half floats per vertex (null if none).
+  const uint16_t* uv() const
+  {
+    return hasUV() ? _uv.data() : nullptr;
+  }
+
+  /// Returns the size in bytes of an index (2 or 4).
+  int indexSize() const
+  {
+    return _indexSize;
+  }
+
+  /// Returns the vertex indices of the triangles, of indexSize() bytes.
+  const void* indices() const
+  {
+    return _indices.data();
+  }
+
+  /// Returns the size in bytes of the quantized data.
+  size_t size() const;
+
+  vec3f position(int i) const;
+  vec3f normal(int i) const;
+  vec2f uv(int i) const;
+  TriangleMesh::Triangle triangle(int i) const;
+
+  /// Returns a new triangle mesh with the decoded data of this mesh.
+  TriangleMesh* decode() const;
+
+  static uint16_t toHalf(float x);
+  static float fromHalf(uint16_t h);
+
+  /// Maps the unit vector n to a point of the square [-1,1]^2 by
+  /// projecting n onto the octahedron |x|+|y|+|z|=1 and unfolding the
+  /// lower half of the octahedron over the corners of the square.
+  static vec2f octEncode(const vec3f& n);
+  static vec3f octDecode(const vec2f& e);
+
+private:
+  int _numberOfVertices;
+  int _numberOfTriangles;
+  Bounds3f _bounds;
+  int _normalBits;
+  int _indexSize;
+  std::vector<uint16_t> _positions;
+  std::vector<int8_t> _normals;
+  std::vector<uint16_t> _uv;
+  std::vector<uint8_t> _indices;
+
+}; // QuantizedMesh
+
+} // end namespace cg
+
+#endif // __QuantizedMesh_h
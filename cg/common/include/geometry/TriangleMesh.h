@@ -35,8 +35,11 @@
 
 #include "core/SharedObject.h"
 #include "geometry/Bounds3.h"
+#include "geometry/MeshAdjacency.h"
+#include "geometry/Meshlets.h"
 #include "graphics/Color.h"
 #include <cstdint>
+#include <vector>
 
 namespace cg
 { // begin namespace cg
@@ -155,30 +158,167 @@ public:
     int numberOfTriangles;
     vec3f* vertices;
     vec3f* vertexNormals;
-    vec2f* uv{}; // TODO
+    vec2f* uv{};
     Triangle* triangles;
 
   }; // Data
 
+  /// Layout of the vertex positions processed by bounds(), TRS() and
+  /// computeNormals().
+  enum class VertexLayout
+  {
+    AoS, // Data::vertices only
+    SoA // separate x, y and z arrays (see VertexArrays)
+  };
+
+  /// Vertex positions as separate x, y and z arrays aligned to
+  /// simd::alignment. Each array has stride floats, a multiple of
+  /// simd::floatsPerLine; the elements past the last vertex repeat it.
+  struct VertexArrays
+  {
+    float* x;
+    float* y;
+    float* z;
+    int stride;
+
+  }; // VertexArrays
+
+  /// Weighting of the triangle normals averaged into vertex normals.
+  enum class NormalWeighting
+  {
+    Uniform,
+    Area,
+    Angle // angle of the triangle at the vertex
+  };
+
+  /// Simplified version of a mesh (see MeshSimplifier).
+  struct LOD
+  {
+    Reference<TriangleMesh> mesh;
+    // Approximate distance between the simplified and the original
+    // surfaces relative to the diagonal of the original bounds
+    float error;
+
+  }; // LOD
+
   const uint32_t id;
   Reference<SharedObject> userData;
+  /// Levels of detail of this mesh, from the finest to the coarsest.
+  std::vector<LOD> lods;
+  /// Meshlets of this mesh, if any (see Meshlets::build()).
+  Reference<Meshlets> meshlets;
 
   /// Constructs a triangle mesh from data.
   TriangleMesh(Data&& data);
 
+  /// Constructs a triangle mesh whose data arrays are owned by
+  /// \c storage (e.g., a memory-mapped file) instead of by the mesh.
+  /// The arrays must be writable and include the vertex normals. If
+  /// given, bounds must be the bounds of the vertices (e.g., as stored
+  /// in the file).
+  TriangleMesh(const Data& data,
+    SharedObject* storage,
+    const Bounds3f* bounds = nullptr);
+
   /// Destructor.
   ~TriangleMesh();
 
-  Bounds3f bounds() const;
+  VertexLayout vertexLayout() const
+  {
+    return _vertexArrays.x != nullptr ? VertexLayout::SoA : VertexLayout::AoS;
+  }
 
-  void computeNormals();
-  void TRS(const mat4f& trs);
+  /// Sets the layout of the vertex positions. With the SoA layout, the
+  /// mesh keeps its positions in vertexArrays(), and Data::vertices is
+  /// an interleaved copy of them for the code reading data(). The copy
+  /// is updated lazily, in one pass over the vertices, by the first
+  /// call to data() or dataChanged() after the positions change (e.g.,
+  /// by TRS()), so repeated calls cost nothing. The SoA arrays take 12
+  /// bytes per vertex (rounded up to simd::floatsPerLine vertices) on
+  /// top of Data::vertices.
+  void setVertexLayout(VertexLayout layout);
+
+  /// Returns the SoA vertex positions (all null with the AoS layout).
+  const VertexArrays& vertexArrays() const
+  {
+    return _vertexArrays;
+  }
+
+  vec3f vertex(int i) const
+  {
+    if (_vertexArrays.x == nullptr)
+      return _data.vertices[i];
+    return {_vertexArrays.x[i], _vertexArrays.y[i], _vertexArrays.z[i]};
+  }
+
+  /// Returns the bounds of the vertices. The bounds are computed on the
+  /// first call and kept until the vertices change (e.g., by TRS()), so
+  /// the first call after a change must not be concurrent with others.
+  Bounds3f bounds() const;
 
+  /// Computes the vertex normals as weighted averages of the normals of
+  /// the triangles of each vertex, using numberOfThreads threads (all
+  /// the hardware threads if numberOfThreads <= 0). The result is the
+  /// same whatever the number of threads.
+  void computeNormals(NormalWeighting weighting = NormalWeighting::Uniform,
+    int numberOfThreads = 0);
+  /// Returns a copy of this mesh with vertex normals averaged only
+  /// across the edges whose triangles make an angle of at most
+  /// creaseAngle degrees. A vertex is split into one copy per smooth
+  /// group of its triangles, if more than one, with the same position
+  /// and uv. Uses numberOfThreads threads (all the hardware threads
+  /// if numberOfThreads <= 0).
+  TriangleMesh* splitCreases(float creaseAngle,
+    NormalWeighting weighting = NormalWeighting::Uniform,
+    int numberOfThreads = 0) const;
+
+  /// Transforms the vertices and normals of this mesh and of its levels
+  /// of detail by trs, using numberOfThreads threads (all the hardware
+  /// threads if numberOfThreads <= 0). The meshlets are transformed as
+  /// well if trs is a similarity (see Meshlets::transform()), and
+  /// discarded otherwise.
+  void TRS(const mat4f& trs, int numberOfThreads = 0);
+
+  /// Returns the mesh data. With the SoA layout, this updates the
+  /// interleaved positions of the data if the vertices have changed
+  /// since they were last interleaved, so the first call after a
+  /// change must not be concurrent with others.
   const Data& data() const
   {
+    if (_verticesChanged)
+      interleaveVertices();
+    return _data;
+  }
+
+  /// Returns the mesh data to be changed in place (e.g., reordered by
+  /// MeshOptimizer). The arrays can be written but not reallocated, and
+  /// dataChanged() must be called when done.
+  Data& editData()
+  {
+    data();
     return _data;
   }
 
+  /// Discards everything derived from the mesh data, i.e., the cached
+  /// bounds, userData (e.g., the GL mesh), the meshlets, the adjacency
+  /// if topologyChanged (e.g., triangles reordered), and the levels of
+  /// detail if geometryChanged (e.g., vertices moved), and brings the
+  /// SoA positions and Data::vertices back in sync: the SoA positions
+  /// are reloaded from Data::vertices, unless they changed after the
+  /// last call to data() or editData(), in which case Data::vertices is
+  /// updated instead.
+  void dataChanged(bool topologyChanged = true, bool geometryChanged = true);
+
+  /// Returns the adjacency of the triangles of this mesh. The adjacency
+  /// is built on the first call and kept until the triangles change,
+  /// so the first call must not be concurrent with others.
+  const MeshAdjacency& adjacency() const;
+
+  /// Returns the coarsest level of detail whose error is at most
+  /// maxError pixels when the diagonal of the bounds of this mesh is
+  /// size pixels long on the screen, or this mesh if there is none.
+  TriangleMesh* lod(float size, float maxError = 1);
+
   bool hasVertexNormals() const
   {
     return _data.vertexNormals != nullptr;
@@ -193,6 +333,15 @@ public:
 
 private:
   Data _data;
+  Reference<SharedObject> _storage;
+  VertexArrays _vertexArrays{};
+  mutable bool _verticesChanged{false};
+  mutable Bounds3f _bounds;
+  mutable bool _hasBounds{false};
+  mutable Reference<MeshAdjacency> _adjacency;
+
+  void loadVertexArrays();
+  void interleaveVertices() const;
 
 }; // TriangleMesh
 
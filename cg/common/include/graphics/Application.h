@@ -77,10 +77,10 @@ public:
     p.loadShaders(assetFilePath(vs), assetFilePath(fs));
   }
 
-  /// Loads a mesh from an OBJ file.
+  /// Loads a mesh from an OBJ, PLY or STL file.
   static TriangleMesh* loadMesh(const char* filename)
   {
-    return MeshReader::readOBJ(assetFilePath(filename).c_str());
+    return MeshReader::read(assetFilePath(filename).c_str());
   }
 
 private:
@@ -33,7 +33,7 @@
 #ifndef __GLMesh_h
 #define __GLMesh_h
 
-#include "geometry/TriangleMesh.h"
+#include "geometry/QuantizedMesh.h"
 #include "graphics/GLProgram.h"
 
 namespace cg
@@ -47,6 +47,10 @@ namespace cg
 class GLMesh: public SharedObject
 {
 public:
+  /// Minimum number of vertices of a mesh uploaded by glMesh() with
+  /// quantized attributes, when asked to.
+  static constexpr int minQuantizedVertices = 4096;
+
   GLMesh(const TriangleMesh& mesh)
   {
     glGenVertexArrays(1, &_vao);
@@ -66,12 +70,81 @@ public:
       glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, 0);
       glEnableVertexAttribArray(1);
     }
-    if (auto s = size<TriangleMesh::Triangle>(m.numberOfTriangles))
+    _vertexCount = m.numberOfTriangles * 3;
+    _indexType = indexType(m.numberOfVertices);
+    if (_vertexCount > 0)
     {
+      auto v = &m.triangles[0].v[0];
+
       glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffers[2]);
-      glBufferData(GL_ELEMENT_ARRAY_BUFFER, s, m.triangles, GL_STATIC_DRAW);
+      if (_indexType == GL_UNSIGNED_BYTE)
+        uploadIndices<GLubyte>(v, _vertexCount);
+      else if (_indexType == GL_UNSIGNED_SHORT)
+        uploadIndices<GLushort>(v, _vertexCount);
+      else
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+          size<int>(_vertexCount),
+          v,
+          GL_STATIC_DRAW);
     }
-    _vertexCount = m.numberOfTriangles * 3;
+    _positionMatrix = mat4f::identity();
+  }
+
+  /// Constructs a GL mesh with normalized integer attributes: the
+  /// positions as 16-bit unsigned integers, mapped to the mesh space by
+  /// positionMatrix(), and the normals, if any, decoded and packed as
+  /// 10-bit signed integers, so that the shaders need not decode them.
+  GLMesh(const QuantizedMesh& mesh)
+  {
+    glGenVertexArrays(1, &_vao);
+    glBindVertexArray(_vao);
+    glGenBuffers(3, _buffers);
+
+    const auto nv = mesh.numberOfVertices();
+
+    if (nv > 0)
+    {
+      glBindBuffer(GL_ARRAY_BUFFER, _buffers[0]);
+      glBufferData(GL_ARRAY_BUFFER,
+        size<uint16_t>(4 * nv),
+        mesh.positions(),
+        GL_STATIC_DRAW);
+      glVertexAttribPointer(0,
+        3,
+        GL_UNSIGNED_SHORT,
+        GL_TRUE,
+        sizeof(uint16_t) * 4,
+        0);
+      glEnableVertexAttribArray(0);
+    }
+    if (nv > 0 && mesh.hasNormals())
+    {
+      std::vector<GLuint> normals(nv);
+
+      for (int i = 0; i < nv; ++i)
+        normals[i] = packNormal(mesh.normal(i));
+      glBindBuffer(GL_ARRAY_BUFFER, _buffers[1]);
+      glBufferData(GL_ARRAY_BUFFER,
+        size<GLuint>(nv),
+        normals.data(),
+        GL_STATIC_DRAW);
+      glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, 0, 0);
+      glEnableVertexAttribArray(1);
+    }
+    _vertexCount = mesh.numberOfTriangles() * 3;
+    _indexType = indexType(nv);
+    if (_vertexCount > 0)
+    {
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffers[2]);
+      if (_indexType == GL_UNSIGNED_BYTE)
+        uploadIndices<GLubyte>((const uint16_t*)mesh.indices(), _vertexCount);
+      else
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+          size_t(mesh.indexSize()) * _vertexCount,
+          mesh.indices(),
+          GL_STATIC_DRAW);
+    }
+    _positionMatrix = mesh.positionMatrix();
   }
 
   ~GLMesh()
@@ -90,10 +163,34 @@ public:
     return _vertexCount;
   }
 
+  /// Returns the type of the vertex indices: GL_UNSIGNED_BYTE,
+  /// GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, the narrowest one able to
+  /// index all the vertices.
+  GLenum indexType() const
+  {
+    return _indexType;
+  }
+
+  /// Returns the size in bytes of a vertex index.
+  int indexSize() const
+  {
+    return _indexType == GL_UNSIGNED_BYTE ? 1 :
+      _indexType == GL_UNSIGNED_SHORT ? 2 : 4;
+  }
+
+  /// Returns the matrix mapping the positions in the vertex buffer to
+  /// the mesh space (identity if the positions are not quantized).
+  const mat4f& positionMatrix() const
+  {
+    return _positionMatrix;
+  }
+
 private:
   GLuint _vao;
   GLuint _buffers[3];
   int _vertexCount;
+  GLenum _indexType;
+  mat4f _positionMatrix;
 
   template <typename T>
   static size_t size(int n)
@@ -101,6 +198,36 @@ private:
     return sizeof(T) * n;
   }
 
+  static GLenum indexType(int numberOfVertices)
+  {
+    if (numberOfVertices <= 256)
+      return GL_UNSIGNED_BYTE;
+    return numberOfVertices <= 65536 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+  }
+
+  // Uploads the n indices v narrowed to T to the bound index buffer
+  template <typename T, typename I>
+  static void uploadIndices(const I* v, int n)
+  {
+    std::vector<T> indices(v, v + n);
+
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+      size<T>(n),
+      indices.data(),
+      GL_STATIC_DRAW);
+  }
+
+  static GLuint packNormal(const vec3f& n)
+  {
+    auto snorm10 = [](float x)
+    {
+      return GLuint(int(std::round(math::clamp(x, -1.0f, 1.0f) * 511))) &
+        0x3ff;
+    };
+
+    return snorm10(n.x) | snorm10(n.y) << 10 | snorm10(n.z) << 20;
+  }
+
 }; // GLMesh
 
 inline GLMesh*
@@ -109,8 +236,13 @@ asGLMesh(SharedObject* object)
   return dynamic_cast<GLMesh*>(object);
 }
 
+/// Returns the GL mesh of mesh, creating it if mesh has none. If
+/// quantized is true, the GL mesh of a new mesh with at least
+/// GLMesh::minQuantizedVertices vertices is created with quantized
+/// attributes (see QuantizedMesh), which saves memory at the cost of
+/// precision.
 inline GLMesh*
-glMesh(TriangleMesh* mesh)
+glMesh(TriangleMesh* mesh, bool quantized = false)
 {
   if (nullptr == mesh)
     return nullptr;
@@ -119,12 +251,49 @@ glMesh(TriangleMesh* mesh)
 
   if (nullptr == ma)
   {
-    ma = new GLMesh{*mesh};
+    if (!quantized
+      || mesh->data().numberOfVertices < GLMesh::minQuantizedVertices)
+      ma = new GLMesh{*mesh};
+    else
+      ma = new GLMesh{QuantizedMesh{*mesh}};
     mesh->userData = ma;
   }
   return ma;
 }
 
+/// Draws the triangles of the meshlets of indices visible (e.g., as
+/// returned by Meshlets::cull()) with the index buffer of the bound GL
+/// mesh, merging the ranges of consecutive meshlets.
+inline void
+drawMeshlets(const GLMesh& mesh,
+  const Meshlets& meshlets,
+  const std::vector<int>& visible)
+{
+  const auto indexSize = mesh.indexSize();
+  std::vector<GLsizei> counts;
+  std::vector<const void*> offsets;
+  auto end = -1;
+
+  for (auto i : visible)
+  {
+    const auto& m = meshlets[i];
+
+    if (m.firstTriangle == end)
+      counts.back() += 3 * m.triangleCount;
+    else
+    {
+      counts.push_back(3 * m.triangleCount);
+      offsets.push_back((const void*)(size_t(indexSize) * 3 * m.firstTriangle));
+    }
+    end = m.firstTriangle + m.triangleCount;
+  }
+  glMultiDrawElements(GL_TRIANGLES,
+    counts.data(),
+    mesh.indexType(),
+    offsets.data(),
+    GLsizei(counts.size()));
+}
+
 } // end namespace cg
 
 #endif // __GLMesh_h
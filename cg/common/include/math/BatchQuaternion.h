@@ -0,0 +1,121 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: BatchQuaternion.h
+// ========
+// Batch operations on arrays of quaternions.
+//
+// Last revision: 18/10/2026
+
+#ifndef __BatchQuaternion_h
+#define __BatchQuaternion_h
+
+#include "math/Quaternion.h"
+
+namespace cg
+{ // begin namespace cg
+
+/// Quaternions as separate x, y, z and w arrays (SoA).
+struct QuaternionArrays
+{
+  float* x;
+  float* y;
+  float* z;
+  float* w;
+
+}; // QuaternionArrays
+
+/// 3D points as separate x, y and z arrays (SoA).
+struct PointArrays
+{
+  float* x;
+  float* y;
+  float* z;
+
+}; // PointArrays
+
+//
+// The functions below compute the same values as the corresponding
+// scalar methods of quatf, four quaternions at a time with SSE when
+// available, except slerpQuaternions(), whose trigonometric functions
+// are evaluated one quaternion at a time. Arrays of n or more elements
+// are split into ranges processed by numberOfThreads threads (all the
+// hardware threads if numberOfThreads <= 0); small arrays are
+// processed by the calling thread. The output arrays can be any of
+// the input arrays.
+//
+
+/// Copies the n quaternions of q into the arrays a.
+void toArrays(const quatf* q, const QuaternionArrays& a, int n);
+
+/// Copies the n quaternions of the arrays a into q.
+void fromArrays(const QuaternionArrays& a, quatf* q, int n);
+
+/// Stores in c the n products a[i] * b[i].
+void multiplyQuaternions(const QuaternionArrays& a,
+  const QuaternionArrays& b,
+  const QuaternionArrays& c,
+  int n,
+  int numberOfThreads = 0);
+
+/// Stores in r the n points p[i] rotated by q[i], as q[i].rotate(p[i]).
+void rotatePoints(const QuaternionArrays& q,
+  const PointArrays& p,
+  const PointArrays& r,
+  int n,
+  int numberOfThreads = 0);
+
+/// Stores in c the n quaternions quatf::nlerp(a[i], b[i], t[i]).
+void nlerpQuaternions(const QuaternionArrays& a,
+  const QuaternionArrays& b,
+  const float* t,
+  const QuaternionArrays& c,
+  int n,
+  int numberOfThreads = 0);
+
+/// Stores in c the n quaternions quatf::slerp(a[i], b[i], t[i]).
+void slerpQuaternions(const QuaternionArrays& a,
+  const QuaternionArrays& b,
+  const float* t,
+  const QuaternionArrays& c,
+  int n,
+  int numberOfThreads = 0);
+
+/// Stores in c approximations of quatf::slerp(a[i], b[i], t[i]) for
+/// t[i] in [0,1], evaluated with a polynomial in the cosine of the
+/// angle between a[i] and b[i] instead of trigonometric functions
+/// (D. Eberly, A Fast and Accurate Algorithm for Computing SLERP,
+/// 2011). The error of each component is at most 1.5e-6 for unit
+/// quaternions, and the results are unit within 1.5e-6.
+void fastSlerpQuaternions(const QuaternionArrays& a,
+  const QuaternionArrays& b,
+  const float* t,
+  const QuaternionArrays& c,
+  int n,
+  int numberOfThreads = 0);
+
+} // end namespace cg
+
+#endif // __BatchQuaternion_h
@@ -0,0 +1,97 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: BatchTransform.h
+// ========
+// Batch transformation of arrays of 3D points and vectors.
+//
+// Last revision: 18/10/2026
+
+#ifndef __BatchTransform_h
+#define __BatchTransform_h
+
+#include "math/Matrix4x4.h"
+
+namespace cg
+{ // begin namespace cg
+
+//
+// The functions below compute the same values as the corresponding
+// scalar methods of mat4f and mat3f, four elements at a time with
+// SSE when available. Arrays of n or more elements are split into
+// ranges transformed by numberOfThreads threads (all the hardware
+// threads if numberOfThreads <= 0); small arrays are transformed by
+// the calling thread. The output array can be the input array; large
+// output arrays distinct from the input are written with streaming
+// stores, which bypass the caches.
+//
+
+/// Stores in q the n points of p transformed by the affine
+/// transformation m, as m.transform3x4(p[i]).
+void transformPoints(const mat4f& m,
+  const vec3f* p,
+  vec3f* q,
+  int n,
+  int numberOfThreads = 0);
+
+/// Transforms in place the n points whose coordinates are in the
+/// separate arrays x, y and z by the affine transformation m. The
+/// arrays are faster to transform if aligned to 16 bytes.
+void transformPoints(const mat4f& m,
+  float* x,
+  float* y,
+  float* z,
+  int n,
+  int numberOfThreads = 0);
+
+/// Stores in q the n homogeneous points of p transformed by m, as
+/// m.transform(p[i]).
+void transformPoints(const mat4f& m,
+  const vec4f* p,
+  vec4f* q,
+  int n,
+  int numberOfThreads = 0);
+
+/// Stores in q the n points of p transformed by the projective
+/// transformation m, as m.transform(p[i]) (i.e., with the homogeneous
+/// divide).
+void projectPoints(const mat4f& m,
+  const vec3f* p,
+  vec3f* q,
+  int n,
+  int numberOfThreads = 0);
+
+/// Stores in w the n vectors of v transformed by m, as m * v[i]. If
+/// normalize is true, the transformed vectors are normalized.
+void transformVectors(const mat3f& m,
+  const vec3f* v,
+  vec3f* w,
+  int n,
+  bool normalize = false,
+  int numberOfThreads = 0);
+
+} // end namespace cg
+
+#endif // __BatchTransform_h
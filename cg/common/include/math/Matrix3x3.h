@@ -61,30 +61,42 @@ public:
 
   /// Constructs a Matrix3x3 object from [v0; v1; v2].
   HOST DEVICE
-  Matrix3x3(const vec3& v0, const vec3& v1, const vec3& v2)
+  constexpr Matrix3x3(const vec3& v0, const vec3& v1, const vec3& v2):
+    v0{v0},
+    v1{v1},
+    v2{v2}
   {
-    set(v0, v1, v2);
+    // do nothing
   }
 
   /// Constructs a Matrix3x3 object from v[9].
   HOST DEVICE
-  explicit Matrix3x3(const real v[])
+  constexpr explicit Matrix3x3(const real v[]):
+    v0{&v[0]},
+    v1{&v[3]},
+    v2{&v[6]}
   {
-    set(v);
+    // do nothing
   }
 
   /// Constructs a Matrix3x3 object as a multiple s of the identity matrix.
   HOST DEVICE
-  explicit Matrix3x3(real s)
+  constexpr explicit Matrix3x3(real s):
+    v0{s, 0, 0},
+    v1{0, s, 0},
+    v2{0, 0, s}
   {
-    set(s);
+    // do nothing
   }
 
   /// Constructs a Matrix3x3 object from the diagonal d.
   HOST DEVICE
-  explicit Matrix3x3(const vec3& d)
+  constexpr explicit Matrix3x3(const vec3& d):
+    v0{d.x, 0, 0},
+    v1{0, d.y, 0},
+    v2{0, 0, d.z}
   {
-    set(d);
+    // do nothing
   }
 
   /// Constructs a Matrix3x3 object from q.
@@ -103,14 +115,14 @@ public:
 
   /// Sets this object to m.
   HOST DEVICE
-  void set(const mat3& m)
+  constexpr void set(const mat3& m)
   {
     *this = m;
   }
 
   /// Sets the columns of this object to [v0; v1; v2].
   HOST DEVICE
-  void set(const vec3& v0, const vec3& v1, const vec3& v2)
+  constexpr void set(const vec3& v0, const vec3& v1, const vec3& v2)
   {
     this->v0 = v0;
     this->v1 = v1;
@@ -119,7 +131,7 @@ public:
 
   /// Sets the elements of this object from v[9].
   HOST DEVICE
-  void set(const real v[])
+  constexpr void set(const real v[])
   {
     v0.set(&v[0]);
     v1.set(&v[3]);
@@ -128,7 +140,7 @@ public:
 
   /// Sets this object to a multiple s of the identity matrix.
   HOST DEVICE
-  void set(real s)
+  constexpr void set(real s)
   {
     v0.set(s, 0, 0);
     v1.set(0, s, 0);
@@ -137,7 +149,7 @@ public:
 
   /// Sets this object to a diagonal matrix d.
   HOST DEVICE
-  void set(const vec3& d)
+  constexpr void set(const vec3& d)
   {
     v0.set(d.x, 0, 0);
     v1.set(0, d.y, 0);
@@ -146,7 +158,7 @@ public:
 
   /// Sets the elements of this object from q.
   HOST DEVICE
-  void set(const quat& q)
+  constexpr void set(const quat& q)
   {
     const auto qx = q.x;
     const auto qy = q.y;
@@ -183,35 +195,35 @@ public:
 
   /// Returns a zero matrix.
   HOST DEVICE
-  static mat3 zero()
+  static constexpr mat3 zero()
   {
     return mat3{real(0)};
   }
 
   /// Returns an identity matrix.
   HOST DEVICE
-  static mat3 identity()
+  static constexpr mat3 identity()
   {
     return mat3{(real)1};
   }
 
   /// Returns a diagonal matrix d.
   HOST DEVICE
-  static mat3 diagonal(const vec3& d)
+  static constexpr mat3 diagonal(const vec3& d)
   {
     return mat3{d};
   }
 
   /// Returns the diagonal of this object.
   HOST DEVICE
-  vec3 diagonal() const
+  constexpr vec3 diagonal() const
   {
     return vec3{v0.x, v1.y, v2.z};
   }
 
   /// Returns the trace of this object.
   HOST DEVICE
-  real trace() const
+  constexpr real trace() const
   {
     return v0.x + v1.y + v2.z;
   }
@@ -246,14 +258,14 @@ public:
 
   /// Returns this object * s.
   HOST DEVICE
-  mat3 operator *(real s) const
+  constexpr mat3 operator *(real s) const
   {
     return mat3{v0 * s, v1 * s, v2 * s};
   }
 
   /// Returns a reference to this object *= s.
   HOST DEVICE
-  mat3& operator *=(real s)
+  constexpr mat3& operator *=(real s)
   {
     v0 *= s;
     v1 *= s;
@@ -263,7 +275,7 @@ public:
 
   /// Returns this object * m.
   HOST DEVICE
-  mat3 operator *(const mat3& m) const
+  constexpr mat3 operator *(const mat3& m) const
   {
     const auto b0 = transform(m.v0);
     const auto b1 = transform(m.v1);
@@ -274,21 +286,21 @@ public:
 
   /// Returns a reference to this object *= m.
   HOST DEVICE
-  mat3& operator *=(const mat3& m)
+  constexpr mat3& operator *=(const mat3& m)
   {
     return *this = operator *(m);
   }
 
   /// Returns this object * v.
   HOST DEVICE
-  vec3 operator *(const vec3& v) const
+  constexpr vec3 operator *(const vec3& v) const
   {
     return transform(v);
   }
 
   /// Returns the transposed of this object.
   HOST DEVICE
-  mat3 transposed() const
+  constexpr mat3 transposed() const
   {
     const vec3 b0{v0.x, v1.x, v2.x};
     const vec3 b1{v0.y, v1.y, v2.y};
@@ -299,7 +311,7 @@ public:
 
   /// Transposes and returns a reference to this object.
   HOST DEVICE
-  mat3& transpose()
+  constexpr mat3& transpose()
   {
     return *this = transposed();
   }
@@ -338,14 +350,14 @@ public:
 
   /// Returns v transformed by this object.
   HOST DEVICE
-  vec3 transform(const vec3& v) const
+  constexpr vec3 transform(const vec3& v) const
   {
     return v0 * v.x + v1 * v.y + v2 * v.z;
   }
 
   /// Returns v transformed by the transposed of this object.
   HOST DEVICE
-  vec3 transposeTransform(const vec3& v) const
+  constexpr vec3 transposeTransform(const vec3& v) const
   {
     return vec3{v0.dot(v), v1.dot(v), v2.dot(v)};
   }
@@ -431,7 +443,7 @@ Quaternion<real>::set(const Matrix3x3<real>& m) // declared in Quaternion.h
 
 /// Returns s * m.
 template <typename real>
-HOST DEVICE inline Matrix3x3<real>
+HOST DEVICE constexpr inline Matrix3x3<real>
 operator *(double s, const Matrix3x3<real>& m)
 {
   return m * real(s);
@@ -65,30 +65,49 @@ public:
 
   /// Constructs a Matrix4x4 object from [v0; v1; v2; v3].
   HOST DEVICE
-  Matrix4x4(const vec4& v0, const vec4& v1, const vec4& v2, const vec4& v3)
+  constexpr Matrix4x4(const vec4& v0,
+    const vec4& v1,
+    const vec4& v2,
+    const vec4& v3):
+    v0{v0},
+    v1{v1},
+    v2{v2},
+    v3{v3}
   {
-    set(v0, v1, v2, v3);
+    // do nothing
   }
 
   /// Constructs a Matrix4x4 object from v[16].
   HOST DEVICE
-  explicit Matrix4x4(const real v[])
+  constexpr explicit Matrix4x4(const real v[]):
+    v0{&v[0x0]},
+    v1{&v[0x4]},
+    v2{&v[0x8]},
+    v3{&v[0xc]}
   {
-    set(v);
+    // do nothing
   }
 
   /// Constructs a Matrix4x4 object as a multiple s of the identity matrix.
   HOST DEVICE
-  explicit Matrix4x4(real s)
+  constexpr explicit Matrix4x4(real s):
+    v0{s, 0, 0, 0},
+    v1{0, s, 0, 0},
+    v2{0, 0, s, 0},
+    v3{0, 0, 0, s}
   {
-    set(s);
+    // do nothing
   }
 
   /// Constructs a Matrix4x4 object from the diagonal d.
   HOST DEVICE
-  explicit Matrix4x4(const vec4& d)
+  constexpr explicit Matrix4x4(const vec4& d):
+    v0{d.x, 0, 0, 0},
+    v1{0, d.y, 0, 0},
+    v2{0, 0, d.z, 0},
+    v3{0, 0, 0, d.w}
   {
-    set(d);
+    // do nothing
   }
 
   /// Constructs a Matrix4x4 object from q and p.
@@ -107,14 +126,17 @@ public:
 
   /// Sets this object to m.
   HOST DEVICE
-  void set(const mat4& m)
+  constexpr void set(const mat4& m)
   {
     *this = m;
   }
 
   /// Sets the columns of this object to [v0; v1; v2; v3].
   HOST DEVICE
-  void set(const vec4& v0, const vec4& v1, const vec4& v2, const vec4& v3)
+  constexpr void set(const vec4& v0,
+    const vec4& v1,
+    const vec4& v2,
+    const vec4& v3)
   {
     this->v0 = v0;
     this->v1 = v1;
@@ -124,7 +146,7 @@ public:
 
   /// Sets the elements of this object from v[16].
   HOST DEVICE
-  void set(const real v[])
+  constexpr void set(const real v[])
   {
     v0.set(&v[0x0]);
     v1.set(&v[0x4]);
@@ -134,7 +156,7 @@ public:
 
   /// Sets this object to a multiply s of the identity matrix.
   HOST DEVICE
-  void set(real s)
+  constexpr void set(real s)
   {
     v0.set(s, 0, 0, 0);
     v1.set(0, s, 0, 0);
@@ -144,7 +166,7 @@ public:
 
   /// Sets this object to a diagonal matrix d.
   HOST DEVICE
-  void set(const vec4& d)
+  constexpr void set(const vec4& d)
   {
     v0.set(d.x, 0, 0, 0);
     v1.set(0, d.y, 0, 0);
@@ -178,28 +200,28 @@ public:
 
   /// Returns a zero matrix.
   HOST DEVICE
-  static mat4 zero()
+  static constexpr mat4 zero()
   {
     return mat4{(real)0};
   }
 
   /// Returns an identity matrix.
   HOST DEVICE
-  static mat4 identity()
+  static constexpr mat4 identity()
   {
     return mat4{(real)1};
   }
 
   /// Returns a diagonal matrix d.
   HOST DEVICE
-  static mat4 diagonal(const vec4& d)
+  static constexpr mat4 diagonal(const vec4& d)
   {
     return mat4{d};
   }
 
   /// Returns the diagonal of this object.
   HOST DEVICE
-  vec4 diagonal() const
+  constexpr vec4 diagonal() const
   {
     return vec4{v0.x, v1.y, v2.z, v3.w};
   }
@@ -234,14 +256,14 @@ public:
 
   /// Returns this object * s.
   HOST DEVICE
-  mat4 operator *(real s) const
+  constexpr mat4 operator *(real s) const
   {
     return mat4{v0 * s, v1 * s, v2 * s, v3 * s};
   }
 
   /// Returns a reference to this object *= s.
   HOST DEVICE
-  mat4& operator *=(real s)
+  constexpr mat4& operator *=(real s)
   {
     v0 *= s;
     v1 *= s;
@@ -252,7 +274,7 @@ public:
 
   /// Returns this object * m.
   HOST DEVICE
-  mat4 operator *(const mat4& m) const
+  constexpr mat4 operator *(const mat4& m) const
   {
     const auto b0 = transform(m.v0);
     const auto b1 = transform(m.v1);
@@ -264,21 +286,21 @@ public:
 
   /// Returns a reference to this object *= m.
   HOST DEVICE
-  mat4& operator *=(const mat4& m)
+  constexpr mat4& operator *=(const mat4& m)
   {
     return *this = operator *(m);
   }
 
   /// Returns this object * v.
   HOST DEVICE
-  vec4 operator *(const vec4& v) const
+  constexpr vec4 operator *(const vec4& v) const
   {
     return transform(v);
   }
 
   /// Returns the transposed of this object.
   HOST DEVICE
-  mat4 transposed() const
+  constexpr mat4 transposed() const
   {
     const vec4 b0{v0.x, v1.x, v2.x, v3.x};
     const vec4 b1{v0.y, v1.y, v2.y, v3.y};
@@ -290,7 +312,7 @@ public:
 
   /// Transposes and returns a reference to this object.
   HOST DEVICE
-  mat4& transpose()
+  constexpr mat4& transpose()
   {
     return *this = transposed();
   }
@@ -341,9 +363,38 @@ public:
     return (m = *this).invert(eps);
   }
 
+  /// \brief Tries to invert this object, assumed to be an affine
+  /// transformation (last row [0 0 0 1]), and returns true on success;
+  /// otherwise, leaves this object unchanged and returns false.
+  /// This method is faster than invert().
+  HOST DEVICE
+  bool invertAffine(real eps = math::Limits<real>::eps())
+  {
+    const vec3 a{v0};
+    const vec3 b{v1};
+    const vec3 c{v2};
+    // Rows of the inverse of the 3x3 part, times its determinant
+    const auto r0 = b.cross(c);
+    const auto r1 = c.cross(a);
+    const auto r2 = a.cross(b);
+    auto d = a.dot(r0);
+
+    if (math::isZero(d, eps))
+      return false;
+    d = real(1 / d);
+
+    const vec3 p{v3};
+
+    v0.set(d * r0.x, d * r1.x, d * r2.x, 0);
+    v1.set(d * r0.y, d * r1.y, d * r2.y, 0);
+    v2.set(d * r0.z, d * r1.z, d * r2.z, 0);
+    v3.set(-d * r0.dot(p), -d * r1.dot(p), -d * r2.dot(p), 1);
+    return true;
+  }
+
   /// Returns a position p transformed by this object.
   HOST DEVICE
-  vec4 transform(const vec4& p) const
+  constexpr vec4 transform(const vec4& p) const
   {
     return v0 * p.x + v1 * p.y + v2 * p.z + v3 * p.w;
   }
@@ -362,7 +413,7 @@ public:
   /// This method is faster than transform, but it can solely
   /// handle affine 3D transformations.
   HOST DEVICE
-  vec3 transform3x4(const vec3& p) const
+  constexpr vec3 transform3x4(const vec3& p) const
   {
     const auto x = v0.x * p.x + v1.x * p.y + v2.x * p.z + v3.x;
     const auto y = v0.y * p.x + v1.y * p.y + v2.y * p.z + v3.y;
@@ -373,11 +424,47 @@ public:
 
   /// Returns a vector v transformed by this object.
   HOST DEVICE
-  vec3 transformVector(const vec3& v) const
+  constexpr vec3 transformVector(const vec3& v) const
   {
     return vec3(v0) * v.x + vec3(v1) * v.y + vec3(v2) * v.z;
   }
 
+  /// Stores in q the n points of p transformed by this object, as
+  /// transform(p[i]). q can be p.
+  HOST DEVICE
+  void transform(const vec4* p, vec4* q, int n) const
+  {
+    for (int i = 0; i < n; ++i)
+      q[i] = transform(p[i]);
+  }
+
+  /// Stores in q the n 3D points of p transformed by this object, as
+  /// transform(p[i]) (i.e., with the homogeneous divide). q can be p.
+  HOST DEVICE
+  void transform(const vec3* p, vec3* q, int n) const
+  {
+    for (int i = 0; i < n; ++i)
+      q[i] = transform(p[i]);
+  }
+
+  /// Stores in q the n 3D points of p transformed by this object, as
+  /// transform3x4(p[i]). q can be p.
+  HOST DEVICE
+  void transform3x4(const vec3* p, vec3* q, int n) const
+  {
+    for (int i = 0; i < n; ++i)
+      q[i] = transform3x4(p[i]);
+  }
+
+  /// Stores in w the n vectors of v transformed by this object, as
+  /// transformVector(v[i]). w can be v.
+  HOST DEVICE
+  void transformVector(const vec3* v, vec3* w, int n) const
+  {
+    for (int i = 0; i < n; ++i)
+      w[i] = transformVector(v[i]);
+  }
+
   /// \brief Returns a translation, rotation, and scaling matrix.
   HOST DEVICE
   static mat4 TRS(const vec3& p, const quat& q, const vec3& s)
@@ -437,43 +524,40 @@ public:
 
   /// Returns an orthographic parallel projection matrix.
   HOST DEVICE
-  static mat4 ortho(real left,
+  static constexpr mat4 ortho(real left,
     real right,
     real bottom,
     real top,
     real zNear,
     real zFar)
   {
-    mat4 m{(real)1};
+    const auto w = right - left;
+    const auto h = top - bottom;
+    const auto d = zFar - zNear;
 
-    m[0][0] = real(2) / (right - left);
-    m[1][1] = real(2) / (top - bottom);
-    m[2][2] = -real(2) / (zFar - zNear);
-    m[3][0] = -(right + left) / (right - left);
-    m[3][1] = -(top + bottom) / (top - bottom);
-    m[3][2] = -(zFar + zNear) / (zFar - zNear);
-    return m;
+    return mat4{vec4{real(2) / w, 0, 0, 0},
+      vec4{0, real(2) / h, 0, 0},
+      vec4{0, 0, -real(2) / d, 0},
+      vec4{-(right + left) / w, -(top + bottom) / h, -(zFar + zNear) / d, 1}};
   }
 
   /// Returns a perspective projection matrix.
   HOST DEVICE
-  static mat4 frustum(real left,
+  static constexpr mat4 frustum(real left,
     real right,
     real bottom,
     real top,
     real zNear,
     real zFar)
   {
-    mat4 m{(real)0};
+    const auto w = right - left;
+    const auto h = top - bottom;
+    const auto d = zFar - zNear;
 
-    m[0][0] = (real(2) * zNear) / (right - left);
-    m[1][1] = (real(2) * zNear) / (top - bottom);
-    m[2][0] = (right + left) / (right - left);
-    m[2][1] = (top + bottom) / (top - bottom);
-    m[2][2] = -(zFar + zNear) / (zFar - zNear);
-    m[2][3] = -real(1);
-    m[3][2] = -real(2) * zFar * zNear / (zFar - zNear);
-    return m;
+    return mat4{vec4{(real(2) * zNear) / w, 0, 0, 0},
+      vec4{0, (real(2) * zNear) / h, 0, 0},
+      vec4{(right + left) / w, (top + bottom) / h, -(zFar + zNear) / d, -1},
+      vec4{0, 0, -real(2) * zFar * zNear / d, 0}};
   }
 
   /// \brief Returns a perspective projection matrix.
@@ -546,7 +630,7 @@ private:
 
 /// Returns s * m.
 template <typename real>
-HOST DEVICE inline Matrix4x4<real>
+HOST DEVICE constexpr inline Matrix4x4<real>
 operator *(double s, const Matrix4x4<real>& m)
 {
   return m * real(s);
@@ -562,6 +646,201 @@ Matrix3x3<real>::set(const Matrix4x4<real>& m) // declared in Matrix3x3.h
   v2 = m[2];
 }
 
+#ifdef DS_USE_SSE
+
+namespace simd
+{ // begin namespace simd
+
+// Returns the cross product of the xyz elements of a and b (the w
+// element is 0 if a.w and b.w are finite)
+inline __m128
+cross(__m128 a, __m128 b)
+{
+  const auto a1 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+  const auto b1 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+  const auto a2 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+  const auto b2 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+
+  return _mm_sub_ps(_mm_mul_ps(a1, b2), _mm_mul_ps(a2, b1));
+}
+
+// Returns the dot products of the pairs (a0, b0), ..., (a3, b3)
+inline __m128
+dot4(__m128 a0, __m128 b0,
+  __m128 a1, __m128 b1,
+  __m128 a2, __m128 b2,
+  __m128 a3, __m128 b3)
+{
+  auto p0 = _mm_mul_ps(a0, b0);
+  auto p1 = _mm_mul_ps(a1, b1);
+  auto p2 = _mm_mul_ps(a2, b2);
+  auto p3 = _mm_mul_ps(a3, b3);
+
+  _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+  return _mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3));
+}
+
+// Returns the columns c transformed by the columns m of a matrix
+inline __m128
+transform(const __m128 m[4], __m128 c)
+{
+  const auto r0 = _mm_mul_ps(m[0], splat<0>(c));
+  const auto r1 = _mm_mul_ps(m[1], splat<1>(c));
+  const auto r2 = _mm_mul_ps(m[2], splat<2>(c));
+  const auto r3 = _mm_mul_ps(m[3], splat<3>(c));
+
+  return _mm_add_ps(_mm_add_ps(r0, r1), _mm_add_ps(r2, r3));
+}
+
+} // end namespace simd
+
+//
+// Matrix4x4<float> specializations
+//
+template <>
+inline Matrix4x4<float>
+Matrix4x4<float>::operator *(const mat4& m) const
+{
+  const __m128 a[4]{
+    simd::load(v0),
+    simd::load(v1),
+    simd::load(v2),
+    simd::load(v3)};
+  mat4 r;
+
+  simd::store(r.v0, simd::transform(a, simd::load(m.v0)));
+  simd::store(r.v1, simd::transform(a, simd::load(m.v1)));
+  simd::store(r.v2, simd::transform(a, simd::load(m.v2)));
+  simd::store(r.v3, simd::transform(a, simd::load(m.v3)));
+  return r;
+}
+
+template <>
+inline Vector4<float>
+Matrix4x4<float>::transform(const vec4& p) const
+{
+  const __m128 a[4]{
+    simd::load(v0),
+    simd::load(v1),
+    simd::load(v2),
+    simd::load(v3)};
+
+  return simd::toVector4(simd::transform(a, simd::load(p)));
+}
+
+template <>
+inline Matrix4x4<float>
+Matrix4x4<float>::transposed() const
+{
+  auto c0 = simd::load(v0);
+  auto c1 = simd::load(v1);
+  auto c2 = simd::load(v2);
+  auto c3 = simd::load(v3);
+  mat4 r;
+
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  simd::store(r.v0, c0);
+  simd::store(r.v1, c1);
+  simd::store(r.v2, c2);
+  simd::store(r.v3, c3);
+  return r;
+}
+
+// Inverts the matrix of columns (a, x), (b, y), (c, z), (d, w), where
+// a, b, c and d are 3D vectors, as in E. Lengyel, Foundations of Game
+// Engine Development, vol. 1, section 1.7.5: with s = a x b, t = c x d,
+// u = ya - xb and v = wc - zd, the rows of the inverse are
+// (b x v + yt, -b.t), (v x a - xt, a.t), (d x u + ws, -d.s) and
+// (u x c - zs, c.s), divided by the determinant s.v + t.u
+template <>
+inline bool
+Matrix4x4<float>::invert(float eps)
+{
+  const auto a = simd::load(v0);
+  const auto b = simd::load(v1);
+  const auto c = simd::load(v2);
+  const auto d = simd::load(v3);
+  const auto x = simd::splat<3>(a);
+  const auto y = simd::splat<3>(b);
+  const auto z = simd::splat<3>(c);
+  const auto w = simd::splat<3>(d);
+  // The w elements of s, t, u and v are 0
+  const auto s = simd::cross(a, b);
+  const auto t = simd::cross(c, d);
+  const auto u = _mm_sub_ps(_mm_mul_ps(y, a), _mm_mul_ps(x, b));
+  const auto v = _mm_sub_ps(_mm_mul_ps(w, c), _mm_mul_ps(z, d));
+  auto det = _mm_cvtss_f32(simd::sum(_mm_add_ps(_mm_mul_ps(s, v),
+    _mm_mul_ps(t, u))));
+
+  if (math::isZero(det, eps))
+    return false;
+
+  const auto k = _mm_set1_ps(1 / det);
+  auto r0 = _mm_add_ps(simd::cross(b, v), _mm_mul_ps(y, t));
+  auto r1 = _mm_sub_ps(simd::cross(v, a), _mm_mul_ps(x, t));
+  auto r2 = _mm_add_ps(simd::cross(d, u), _mm_mul_ps(w, s));
+  auto r3 = _mm_sub_ps(simd::cross(u, c), _mm_mul_ps(z, s));
+  // The last column of the inverse is (-b.t, a.t, -d.s, c.s)
+  auto c3 = _mm_xor_ps(simd::dot4(b, t, a, t, d, s, c, s),
+    _mm_set_ps(0, -0.0f, 0, -0.0f));
+
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  simd::store(v0, _mm_mul_ps(r0, k));
+  simd::store(v1, _mm_mul_ps(r1, k));
+  simd::store(v2, _mm_mul_ps(r2, k));
+  simd::store(v3, _mm_mul_ps(c3, k));
+  return true;
+}
+
+template <>
+inline bool
+Matrix4x4<float>::invertAffine(float eps)
+{
+  const auto a = simd::load(v0);
+  const auto b = simd::load(v1);
+  const auto c = simd::load(v2);
+  const auto p = simd::load(v3);
+  // Rows of the inverse of the 3x3 part, times its determinant
+  auto r0 = simd::cross(b, c);
+  auto r1 = simd::cross(c, a);
+  auto r2 = simd::cross(a, b);
+  auto r3 = _mm_setzero_ps();
+  auto det = _mm_cvtss_f32(simd::sum(_mm_mul_ps(a, r0)));
+
+  if (math::isZero(det, eps))
+    return false;
+
+  const auto k = _mm_set1_ps(1 / det);
+  const auto q = simd::dot4(r0, p, r1, p, r2, p, r3, p);
+
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  simd::store(v0, _mm_mul_ps(r0, k));
+  simd::store(v1, _mm_mul_ps(r1, k));
+  simd::store(v2, _mm_mul_ps(r2, k));
+  simd::store(v3, _mm_sub_ps(_mm_set_ps(1, 0, 0, 0), _mm_mul_ps(q, k)));
+  return true;
+}
+
+//
+// The batch transforms of arrays of floats are vectorized and, if the
+// arrays are large, multithreaded (see BatchTransform.cpp)
+//
+template <>
+void Matrix4x4<float>::transform(const vec4* p, vec4* q, int n) const;
+
+template <>
+void Matrix4x4<float>::transform(const vec3* p, vec3* q, int n) const;
+
+template <>
+void Matrix4x4<float>::transform3x4(const vec3* p, vec3* q, int n) const;
+
+template <>
+void Matrix4x4<float>::transformVector(const vec3* v,
+  vec3* w,
+  int n) const;
+
+#endif // DS_USE_SSE
+
 using mat4f = cg::Matrix4x4<float>;
 using mat4d = cg::Matrix4x4<double>;
 
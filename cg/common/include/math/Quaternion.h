@@ -101,30 +101,46 @@ public:
 
   /// Constructs a Quaternion object from [(x, y, z), w].
   HOST DEVICE
-  Quaternion(real x, real y, real z, real w)
+  constexpr Quaternion(real x, real y, real z, real w):
+    x{x},
+    y{y},
+    z{z},
+    w{w}
   {
-    set(x, y, z, w);
+    // do nothing
   }
 
   /// Constructs a Quaternion object from q[4].
   HOST DEVICE
-  explicit Quaternion(const real q[])
+  constexpr explicit Quaternion(const real q[]):
+    x{q[0]},
+    y{q[1]},
+    z{q[2]},
+    w{q[3]}
   {
-    set(q);
+    // do nothing
   }
 
   /// Constructs a Quaternion object from [(0, 0, 0), w].
   HOST DEVICE
-  explicit Quaternion(real w)
+  constexpr explicit Quaternion(real w):
+    x{0},
+    y{0},
+    z{0},
+    w{w}
   {
-    set(w);
+    // do nothing
   }
 
   /// Constructs a Quaternion object from [v, w].
   HOST DEVICE
-  explicit Quaternion(const vec3& v, real w = 0)
+  constexpr explicit Quaternion(const vec3& v, real w = 0):
+    x{v.x},
+    y{v.y},
+    z{v.z},
+    w{w}
   {
-    set(v, w);
+    // do nothing
   }
 
   /// Constructs a Quaternion object from angle (in degrees) and axis.
@@ -144,7 +160,7 @@ public:
   /// Constructs a Quaternion object from v.
   HOST DEVICE
   template <typename V>
-  explicit Quaternion(const V& v):
+  constexpr explicit Quaternion(const V& v):
     x{real(v.x)},
     y{real(v.y)},
     z{real(v.z)},
@@ -155,14 +171,14 @@ public:
 
   /// Sets this object to q.
   HOST DEVICE
-  void set(const quat& q)
+  constexpr void set(const quat& q)
   {
     *this = q;
   }
 
   /// Sets the coordinates of this object to [(x, y, z), w].
   HOST DEVICE
-  void set(real x, real y, real z, real w)
+  constexpr void set(real x, real y, real z, real w)
   {
     this->x = x;
     this->y = y;
@@ -172,7 +188,7 @@ public:
 
   /// Sets the coordinates of this object to q[4].
   HOST DEVICE
-  void set(const real q[])
+  constexpr void set(const real q[])
   {
     x = q[0];
     y = q[1];
@@ -182,7 +198,7 @@ public:
 
   /// Sets the coordinates of this object to [(0, 0, 0), w].
   HOST DEVICE
-  void set(real w)
+  constexpr void set(real w)
   {
     x = y = z = 0;
     this->w = w;
@@ -190,7 +206,7 @@ public:
 
   /// Sets the coordinates of this object to [v, w].
   HOST DEVICE
-  void set(const vec3& v, real w = 0)
+  constexpr void set(const vec3& v, real w = 0)
   {
     x = v.x;
     y = v.y;
@@ -215,7 +231,7 @@ public:
   /// Sets the coordinates of this object from v.
   HOST DEVICE
   template <typename V>
-  void set(const V& v)
+  constexpr void set(const V& v)
   {
     set(real(v.x), real(v.y), real(v.z), real(v.w));
   }
@@ -237,7 +253,7 @@ public:
 
   /// Returns an identity quaternion.
   HOST DEVICE
-  static quat identity()
+  static constexpr quat identity()
   {
     return quat{real(1)};
   }
@@ -303,7 +319,7 @@ public:
 
   /// Returns a reference to this object += q.
   HOST DEVICE
-  quat& operator +=(const quat& q)
+  constexpr quat& operator +=(const quat& q)
   {
     x += q.x;
     y += q.y;
@@ -314,7 +330,7 @@ public:
 
   /// Returns a reference to this object -= q.
   HOST DEVICE
-  quat& operator -=(const quat& q)
+  constexpr quat& operator -=(const quat& q)
   {
     x -= q.x;
     y -= q.y;
@@ -325,7 +341,7 @@ public:
 
   /// Returns a reference to this object *= s.
   HOST DEVICE
-  quat& operator *=(real s)
+  constexpr quat& operator *=(real s)
   {
     x *= s;
     y *= s;
@@ -336,35 +352,35 @@ public:
 
   /// Returns a reference to this object *= q.
   HOST DEVICE
-  quat& operator *=(const quat& q)
+  constexpr quat& operator *=(const quat& q)
   {
     return *this = operator *(q);
   }
 
   /// Returns this object + q.
   HOST DEVICE
-  quat operator +(const quat& q) const
+  constexpr quat operator +(const quat& q) const
   {
     return quat{x + q.x, y + q.y, z + q.z, w + q.w};
   }
 
   /// Returns this object + q.
   HOST DEVICE
-  quat operator -(const quat& q) const
+  constexpr quat operator -(const quat& q) const
   {
     return quat{x - q.x, y - q.y, z - q.z, w - q.w};
   }
 
   /// Returns this object * s.
   HOST DEVICE
-  quat operator *(real s) const
+  constexpr quat operator *(real s) const
   {
     return quat{x * s, y * s, z * s, w * s};
   }
 
   /// Returns this object * q.
   HOST DEVICE
-  quat operator *(const quat& q) const
+  constexpr quat operator *(const quat& q) const
   {
     const auto cx = w * q.x + q.w * x + y * q.z - q.y * z;
     const auto cy = w * q.y + q.w * y + z * q.x - q.z * x;
@@ -376,28 +392,28 @@ public:
 
   /// Returns this object * v.
   HOST DEVICE
-  vec3 operator *(const vec3& v) const
+  constexpr vec3 operator *(const vec3& v) const
   {
     return rotate(v);
   }
 
   /// Returns this object * -1.
   HOST DEVICE
-  quat operator -() const
+  constexpr quat operator -() const
   {
     return quat{-x, -y, -z, -w};
   }
 
   /// Returns the conjugate of this object.
   HOST DEVICE
-  quat operator ~() const
+  constexpr quat operator ~() const
   {
     return quat{-x, -y, -z, +w};
   }
 
   /// Returns the squared norm of this object.
   HOST DEVICE
-  real squaredNorm() const
+  constexpr real squaredNorm() const
   {
     return math::sqr(x) + math::sqr(y) + math::sqr(z) + math::sqr(w);
   }
@@ -429,7 +445,7 @@ public:
 
   /// Negates and returns a reference to this object.
   HOST DEVICE
-  quat& negate()
+  constexpr quat& negate()
   {
     x = -x;
     y = -y;
@@ -450,7 +466,7 @@ public:
 
   /// Returns the conjugate of this object.
   HOST DEVICE
-  quat conjugate() const
+  constexpr quat conjugate() const
   {
     return operator ~();
   }
@@ -462,9 +478,46 @@ public:
     return conjugate().normalize();
   }
 
+  /// Returns the dot product of this object and q.
+  HOST DEVICE
+  constexpr real dot(const quat& q) const
+  {
+    return x * q.x + y * q.y + z * q.z + w * q.w;
+  }
+
+  /// Returns the normalized linear interpolation of the unit
+  /// quaternions a and b by t, along the shortest arc.
+  HOST DEVICE
+  static quat nlerp(const quat& a, const quat& b, real t)
+  {
+    const auto s = a.dot(b) < 0 ? real(-1) : real(1);
+    auto q = a * (1 - t) + b * (s * t);
+
+    return q.normalize();
+  }
+
+  /// Returns the spherical linear interpolation of the unit
+  /// quaternions a and b by t, along the shortest arc.
+  HOST DEVICE
+  static quat slerp(const quat& a, const quat& b, real t)
+  {
+    auto d = a.dot(b);
+    const auto s = d < 0 ? real(-1) : real(1);
+
+    // Nearly parallel quaternions are interpolated linearly
+    if ((d *= s) > real(0.9995))
+      return nlerp(a, b, t);
+
+    const auto theta = real(acos(d));
+    const auto k = math::inverse(real(sin(theta)));
+
+    return a * real(sin((1 - t) * theta) * k) +
+      b * real(s * sin(t * theta) * k);
+  }
+
   /// Returns the point p rotated by this object.
   HOST DEVICE
-  vec3 rotate(const vec3& p) const
+  constexpr vec3 rotate(const vec3& p) const
   {
     const auto vx = real(2) * p.x;
     const auto vy = real(2) * p.y;
@@ -480,7 +533,7 @@ public:
 
   /// Returns the point p rotated by the inverse of this object.
   HOST DEVICE
-  vec3 inverseRotate(const vec3& p) const
+  constexpr vec3 inverseRotate(const vec3& p) const
   {
     const auto vx = real(2) * p.x;
     const auto vy = real(2) * p.y;
@@ -537,7 +590,7 @@ Quaternion<real>::eulerAngles() const
 
 /// Returns the scalar multiplication of s and q.
 template <typename real>
-HOST DEVICE inline Quaternion<real>
+HOST DEVICE constexpr inline Quaternion<real>
 operator *(double s, const Quaternion<real>& q)
 {
   return q * real(s);
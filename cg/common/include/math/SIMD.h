@@ -0,0 +1,79 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: SIMD.h
+// ========
+// SIMD configuration and aligned allocation.
+//
+// Last revision: 18/10/2026
+
+#ifndef __SIMD_h
+#define __SIMD_h
+
+#include <cstddef>
+#include <new>
+
+// SSE2 is always available on x64; define DS_NO_SIMD to use the
+// scalar code paths instead
+#if !defined(DS_NO_SIMD) && !defined(DS_USE_CUDA) \
+  && (defined(__SSE2__) || defined(_M_X64))
+#define DS_USE_SSE
+#include <emmintrin.h>
+#endif
+
+namespace cg
+{ // begin namespace cg
+
+namespace simd
+{ // begin namespace simd
+
+/// Alignment, in bytes, of the arrays processed by SIMD kernels
+/// (a cache line, which also suits AVX-512 loads).
+constexpr size_t alignment{64};
+
+/// Number of floats in alignment bytes.
+constexpr int floatsPerLine{int(alignment / sizeof(float))};
+
+/// Allocates an array of n elements of type T aligned to alignment.
+template <typename T>
+inline T*
+allocate(size_t n)
+{
+  return (T*)::operator new[](n * sizeof(T), std::align_val_t{alignment});
+}
+
+/// Deallocates an array allocated by allocate().
+template <typename T>
+inline void
+deallocate(T* p)
+{
+  ::operator delete[](p, std::align_val_t{alignment});
+}
+
+} // end namespace simd
+
+} // end namespace cg
+
+#endif // __SIMD_h
@@ -0,0 +1,480 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: Vector.h
+// ========
+// Class definition for the core of fixed-size vectors.
+//
+// Last revision: 18/10/2026
+
+#ifndef __Vector_h
+#define __Vector_h
+
+#include "math/Real.h"
+#include <algorithm>
+#include <cstdio>
+#include <type_traits>
+#include <utility>
+
+namespace cg
+{ // begin namespace cg
+
+// Forward definitions
+template <typename real> class Vector2;
+template <typename real> class Vector3;
+template <typename real> class Vector4;
+
+namespace internal
+{ // begin namespace internal
+
+// Coordinates of an N-dimensional vector
+template <typename real, int N> struct VectorCoordinates;
+
+template <typename real>
+struct VectorCoordinates<real, 2>
+{
+  real x;
+  real y;
+
+  HOST DEVICE
+  VectorCoordinates() = default;
+
+  HOST DEVICE
+  constexpr VectorCoordinates(real x, real y):
+    x{x},
+    y{y}
+  {
+    // do nothing
+  }
+
+}; // VectorCoordinates<real, 2>
+
+template <typename real>
+struct VectorCoordinates<real, 3>
+{
+  real x;
+  real y;
+  real z;
+
+  HOST DEVICE
+  VectorCoordinates() = default;
+
+  HOST DEVICE
+  constexpr VectorCoordinates(real x, real y, real z):
+    x{x},
+    y{y},
+    z{z}
+  {
+    // do nothing
+  }
+
+}; // VectorCoordinates<real, 3>
+
+template <typename real>
+struct VectorCoordinates<real, 4>
+{
+  real x;
+  real y;
+  real z;
+  real w;
+
+  HOST DEVICE
+  VectorCoordinates() = default;
+
+  HOST DEVICE
+  constexpr VectorCoordinates(real x, real y, real z, real w):
+    x{x},
+    y{y},
+    z{z},
+    w{w}
+  {
+    // do nothing
+  }
+
+}; // VectorCoordinates<real, 4>
+
+} // end namespace internal
+
+
+/////////////////////////////////////////////////////////////////////
+//
+// Vector: core of N-dimensional vector classes
+// ======
+// Vector<real, N> implements once the operations common to Vector2,
+// Vector3 and Vector4, which derive from it. The operations are
+// expanded coordinate by coordinate at compile time and, except those
+// depending on sqrt() and fabs(), are constexpr.
+//
+template <typename real, int N>
+class Vector: public internal::VectorCoordinates<real, N>
+{
+public:
+  using vec = std::conditional_t<N == 2,
+    Vector2<real>,
+    std::conditional_t<N == 3, Vector3<real>, Vector4<real>>>;
+  using value_type = real;
+
+  using internal::VectorCoordinates<real, N>::VectorCoordinates;
+
+  /// Returns a null vector.
+  HOST DEVICE
+  static constexpr vec null()
+  {
+    return vec{real(0)};
+  }
+
+  /// Returns the size of this object.
+  HOST DEVICE
+  static constexpr int size()
+  {
+    return N;
+  }
+
+  /// Returns a reference to the i-th coordinate of this object.
+  template <int i>
+  HOST DEVICE
+  constexpr real& get()
+  {
+    static_assert(i >= 0 && i < N, "Bad vector coordinate");
+    if constexpr (i == 0)
+      return this->x;
+    else if constexpr (i == 1)
+      return this->y;
+    else if constexpr (i == 2)
+      return this->z;
+    else
+      return this->w;
+  }
+
+  /// Returns the i-th coordinate of this object.
+  template <int i>
+  HOST DEVICE
+  constexpr const real& get() const
+  {
+    return const_cast<Vector*>(this)->template get<i>();
+  }
+
+  /// Sets the coordinates of this object to (s, ..., s).
+  HOST DEVICE
+  constexpr void set(real s)
+  {
+    apply([s](real& a) { a = s; }, index{});
+  }
+
+  /// Sets the coordinates of this object to v[N].
+  HOST DEVICE
+  constexpr void set(const real v[])
+  {
+    assign(v, index{});
+  }
+
+  /// Returns true if this object is equal to v.
+  HOST DEVICE
+  bool equals(const vec& v, real eps = math::Limits<real>::eps()) const
+  {
+    return (*this - v).isNull(eps);
+  }
+
+  HOST DEVICE
+  bool operator ==(const vec& v) const
+  {
+    return equals(v);
+  }
+
+  /// Returns true if this object is not equal to v.
+  HOST DEVICE
+  bool operator !=(const vec& v) const
+  {
+    return !operator ==(v);
+  }
+
+  /// Returns a reference to this object += v.
+  HOST DEVICE
+  constexpr vec& operator +=(const vec& v)
+  {
+    return apply(v, [](real& a, real b) { a += b; }, index{});
+  }
+
+  /// Returns a reference to this object -= v.
+  HOST DEVICE
+  constexpr vec& operator -=(const vec& v)
+  {
+    return apply(v, [](real& a, real b) { a -= b; }, index{});
+  }
+
+  /// Returns a reference to this object *= s.
+  HOST DEVICE
+  constexpr vec& operator *=(real s)
+  {
+    return apply([s](real& a) { a *= s; }, index{});
+  }
+
+  /// Returns a reference to this object *= v.
+  HOST DEVICE
+  constexpr vec& operator *=(const vec& v)
+  {
+    return apply(v, [](real& a, real b) { a *= b; }, index{});
+  }
+
+  /// Returns a reference to the i-th coordinate of this object.
+  HOST DEVICE
+  real& operator [](int i)
+  {
+    return (&this->x)[i];
+  }
+
+  /// Returns the i-th coordinate of this object.
+  HOST DEVICE
+  const real& operator [](int i) const
+  {
+    return (&this->x)[i];
+  }
+
+  /// Returns a pointer to the elements of this object.
+  HOST DEVICE
+  explicit operator const real*() const
+  {
+    return &this->x;
+  }
+
+  /// Returns this object + v.
+  HOST DEVICE
+  constexpr vec operator +(const vec& v) const
+  {
+    return map(v, [](real a, real b) { return a + b; }, index{});
+  }
+
+  /// Returns this object - v.
+  HOST DEVICE
+  constexpr vec operator -(const vec& v) const
+  {
+    return map(v, [](real a, real b) { return a - b; }, index{});
+  }
+
+  /// Returns a vector in the direction opposite to this object.
+  HOST DEVICE
+  constexpr vec operator -() const
+  {
+    return map([](real a) { return -a; }, index{});
+  }
+
+  /// Returns the scalar multiplication of this object and s.
+  HOST DEVICE
+  constexpr vec operator *(real s) const
+  {
+    return map([s](real a) { return a * s; }, index{});
+  }
+
+  /// Returns the multiplication of this object and v.
+  HOST DEVICE
+  constexpr vec operator *(const vec& v) const
+  {
+    return map(v, [](real a, real b) { return a * b; }, index{});
+  }
+
+  /// Returns true if this object is null.
+  HOST DEVICE
+  bool isNull(real eps = math::Limits<real>::eps()) const
+  {
+    return isZero(eps, index{});
+  }
+
+  /// Returns the squared norm of this object.
+  HOST DEVICE
+  constexpr real squaredNorm() const
+  {
+    return dotProduct(*this, index{});
+  }
+
+  /// Returns the length of this object.
+  HOST DEVICE
+  real length() const
+  {
+    return real(sqrt(squaredNorm()));
+  }
+
+  /// Returns the maximum coordinate of this object.
+  HOST DEVICE
+  constexpr real max() const
+  {
+    return reduce([](real a, real b) { return std::max(a, b); }, tail{});
+  }
+
+  /// Returns the minimum coordinate of this object.
+  HOST DEVICE
+  constexpr real min() const
+  {
+    return reduce([](real a, real b) { return std::min(a, b); }, tail{});
+  }
+
+  /// Returns the inverse of this object.
+  HOST DEVICE
+  constexpr vec inverse() const
+  {
+    return map([](real a) { return 1 / a; }, index{});
+  }
+
+  /// Inverts and returns a reference to this object.
+  HOST DEVICE
+  constexpr vec& invert()
+  {
+    return apply([](real& a) { a = 1 / a; }, index{});
+  }
+
+  /// Negates and returns a reference to this object.
+  HOST DEVICE
+  constexpr vec& negate()
+  {
+    return apply([](real& a) { a = -a; }, index{});
+  }
+
+  /// Normalizes and returns a reference to this object.
+  HOST DEVICE
+  vec& normalize(real eps = math::Limits<real>::eps())
+  {
+    const auto len = length();
+
+    if (!math::isZero(len, eps))
+      operator *=(math::inverse(len));
+    return static_cast<vec&>(*this);
+  }
+
+  /// Returns the unit vector of this this object.
+  HOST DEVICE
+  vec versor(real eps = math::Limits<real>::eps()) const
+  {
+    return vec(static_cast<const vec&>(*this)).normalize(eps);
+  }
+
+  /// Returns the unit vector of v.
+  HOST DEVICE
+  static vec versor(const vec& v, real eps = math::Limits<real>::eps())
+  {
+    return v.versor(eps);
+  }
+
+  /// Returns the dot product of this object and v.
+  HOST DEVICE
+  constexpr real dot(const vec& v) const
+  {
+    return dotProduct(v, index{});
+  }
+
+  /// Returns the dot product of v and w.
+  HOST DEVICE
+  static constexpr real dot(const vec& v, const vec& w)
+  {
+    return v.dot(w);
+  }
+
+private:
+  using index = std::make_integer_sequence<int, N>;
+  using tail = std::make_integer_sequence<int, N - 1>;
+
+  // Returns (f(x), f(y), ...)
+  template <typename F, int... i>
+  HOST DEVICE
+  constexpr vec map(F f, std::integer_sequence<int, i...>) const
+  {
+    return vec{f(get<i>())...};
+  }
+
+  // Returns (f(x, v.x), f(y, v.y), ...)
+  template <typename F, int... i>
+  HOST DEVICE
+  constexpr vec map(const Vector& v,
+    F f,
+    std::integer_sequence<int, i...>) const
+  {
+    return vec{f(get<i>(), v.get<i>())...};
+  }
+
+  // Calls f(x), f(y), ... and returns a reference to this object
+  template <typename F, int... i>
+  HOST DEVICE
+  constexpr vec& apply(F f, std::integer_sequence<int, i...>)
+  {
+    (f(get<i>()), ...);
+    return static_cast<vec&>(*this);
+  }
+
+  // Calls f(x, v.x), f(y, v.y), ... and returns a reference to this
+  // object
+  template <typename F, int... i>
+  HOST DEVICE
+  constexpr vec& apply(const Vector& v,
+    F f,
+    std::integer_sequence<int, i...>)
+  {
+    (f(get<i>(), v.get<i>()), ...);
+    return static_cast<vec&>(*this);
+  }
+
+  // Returns f(...f(f(x, y), z)...)
+  template <typename F, int... i>
+  HOST DEVICE
+  constexpr real reduce(F f, std::integer_sequence<int, i...>) const
+  {
+    auto r = this->x;
+
+    ((r = f(r, get<i + 1>())), ...);
+    return r;
+  }
+
+  template <int... i>
+  HOST DEVICE
+  constexpr void assign(const real v[], std::integer_sequence<int, i...>)
+  {
+    ((get<i>() = v[i]), ...);
+  }
+
+  template <int... i>
+  HOST DEVICE
+  bool isZero(real eps, std::integer_sequence<int, i...>) const
+  {
+    return (math::isZero(get<i>(), eps) && ...);
+  }
+
+  template <int... i>
+  HOST DEVICE
+  constexpr real dotProduct(const Vector& v,
+    std::integer_sequence<int, i...>) const
+  {
+    return (... + (get<i>() * v.get<i>()));
+  }
+
+}; // Vector
+
+/// Returns the scalar multiplication of s and v.
+template <typename real, int N>
+HOST DEVICE constexpr inline auto
+operator *(double s, const Vector<real, N>& v)
+{
+  return v * real(s);
+}
+
+} // end namespace cg
+
+#endif // __Vector_h
@@ -44,16 +44,17 @@ namespace cg
 // Vector3: 3D vector class
 // =======
 template <typename real>
-class Vector3
+class Vector3: public Vector<real, 3>
 {
 public:
+  using Vector<real, 3>::x;
+  using Vector<real, 3>::y;
+  using Vector<real, 3>::z;
+  using Vector<real, 3>::set;
+  using Vector<real, 3>::dot;
+
   using vec2 = Vector2<real>;
   using vec3 = Vector3<real>;
-  using value_type = real;
-
-  real x;
-  real y;
-  real z;
 
   /// Default constructor.
   HOST DEVICE
@@ -61,77 +62,63 @@ public:
 
   /// Constructs a Vector3 object from (x, y, z).
   HOST DEVICE
-  Vector3(real x, real y, real z = 0)
+  constexpr Vector3(real x, real y, real z = 0):
+    Vector<real, 3>{x, y, z}
   {
-    set(x, y, z);
+    // do nothing
   }
 
   /// Constructs a Vector3 object from v[3].
   HOST DEVICE
-  explicit Vector3(const real v[])
+  constexpr explicit Vector3(const real v[]):
+    Vector<real, 3>{v[0], v[1], v[2]}
   {
-    set(v);
+    // do nothing
   }
 
   /// Constructs a Vector3 object with (s, s, s).
   HOST DEVICE
-  explicit Vector3(real s)
+  constexpr explicit Vector3(real s):
+    Vector<real, 3>{s, s, s}
   {
-    set(s);
+    // do nothing
   }
 
   /// Constructs a Vector3 object from (v, z).
   HOST DEVICE
-  explicit Vector3(const vec2& v, real z = 0)
+  constexpr explicit Vector3(const vec2& v, real z = 0):
+    Vector<real, 3>{v.x, v.y, z}
   {
-    set(v, z);
+    // do nothing
   }
 
   HOST DEVICE
   template <typename V>
-  explicit Vector3(const V& v):
-    x{real(v.x)},
-    y{real(v.y)},
-    z{real(v.z)}
+  constexpr explicit Vector3(const V& v):
+    Vector<real, 3>{real(v.x), real(v.y), real(v.z)}
   {
     // do nothing
   }
 
   /// Sets this object to v.
   HOST DEVICE
-  void set(const vec3& v)
+  constexpr void set(const vec3& v)
   {
     *this = v;
   }
 
   /// Sets the coordinates of this object to (x, y, z).
   HOST DEVICE
-  void set(real x, real y, real z = 0)
+  constexpr void set(real x, real y, real z = 0)
   {
     this->x = x;
     this->y = y;
     this->z = z;
   }
 
-  /// Sets the coordinates of this object to v[3].
-  HOST DEVICE
-  void set(const real v[])
-  {
-    x = v[0];
-    y = v[1];
-    z = v[2];
-  }
-
-  /// Sets the coordinates of this object to (s, s, s).
-  HOST DEVICE
-  void set(real s)
-  {
-    x = y = z = s;
-  }
-
   /// Sets the coordinates of this object to (v, z).
   HOST DEVICE
-  void set(const vec2& v, real z = 0)
+  constexpr void set(const vec2& v, real z = 0)
   {
     x = v.x;
     y = v.y;
@@ -141,260 +128,36 @@ public:
   /// Sets the coordinates of this object from v.
   HOST DEVICE
   template <typename V>
-  void set(const V& v)
+  constexpr void set(const V& v)
   {
     set(real(v.x), real(v.y), real(v.z));
   }
 
   HOST DEVICE
   template <typename V>
-  vec3& operator =(const V& v)
+  constexpr vec3& operator =(const V& v)
   {
     set(v);
     return *this;
   }
 
-  /// Returns a null vector.
-  HOST DEVICE
-  static vec3 null()
-  {
-    return vec3{real(0)};
-  }
-
   /// Returns the up vector.
   HOST DEVICE
-  static vec3 up()
+  static constexpr vec3 up()
   {
     return vec3{real(0), real(1), real(0)};
   }
 
-  /// Returns true if this object is equal to v.
-  HOST DEVICE
-  bool equals(const vec3& v, real eps = math::Limits<real>::eps()) const
-  {
-    return math::isNull(x - v.x, y - v.y, z - v.z, eps);
-  }
-
-  HOST DEVICE
-  bool operator ==(const vec3& v) const
-  {
-    return equals(v);
-  }
-
-  /// Returns true if this object is not equal to v.
-  HOST DEVICE
-  bool operator !=(const vec3& v) const
-  {
-    return !operator ==(v);
-  }
-
-  /// Returns a reference to this object += v.
-  HOST DEVICE
-  vec3& operator +=(const vec3& v)
-  {
-    x += v.x;
-    y += v.y;
-    z += v.z;
-    return *this;
-  }
-
-  /// Returns a reference to this object -= v.
-  HOST DEVICE
-  vec3& operator -=(const vec3& v)
-  {
-    x -= v.x;
-    y -= v.y;
-    z -= v.z;
-    return *this;
-  }
-
-  /// Returns a reference to this object *= s.
-  HOST DEVICE
-  vec3& operator *=(real s)
-  {
-    x *= s;
-    y *= s;
-    z *= s;
-    return *this;
-  }
-
-  /// Returns a reference to this object *= v.
-  HOST DEVICE
-  vec3& operator *=(const vec3& v)
-  {
-    x *= v.x;
-    y *= v.y;
-    z *= v.z;
-    return *this;
-  }
-
-  /// Returns a reference to the i-th coordinate of this object.
-  HOST DEVICE
-  real& operator [](int i)
-  {
-    return (&x)[i];
-  }
-
-  /// Returns the i-th coordinate of this object.
-  HOST DEVICE
-  const real& operator [](int i) const
-  {
-    return (&x)[i];
-  }
-
-  /// Returns a pointer to the elements of this object.
-  HOST DEVICE
-  explicit operator const real*() const
-  {
-    return &x;
-  }
-
-  /// Returns this object + v.
-  HOST DEVICE
-  vec3 operator +(const vec3& v) const
-  {
-    return vec3{x + v.x, y + v.y, z + v.z};
-  }
-
-  /// Returns this object - v.
-  HOST DEVICE
-  vec3 operator -(const vec3& v) const
-  {
-    return vec3{x - v.x, y - v.y, z - v.z};
-  }
-
-  /// Returns a vector in the direction opposite to this object.
-  HOST DEVICE
-  vec3 operator -() const
-  {
-    return vec3{-x, -y, -z};
-  }
-
-  /// Returns the scalar multiplication of this object and s.
-  HOST DEVICE
-  vec3 operator *(real s) const
-  {
-    return vec3{x * s, y * s, z * s};
-  }
-
-  /// Returns the multiplication of this object and v.
-  HOST DEVICE
-  vec3 operator *(const vec3& v) const
-  {
-    return vec3{x * v.x, y * v.y, z * v.z};
-  }
-
-  /// Returns true if this object is null.
-  HOST DEVICE
-  bool isNull(real eps = math::Limits<real>::eps()) const
-  {
-    return math::isNull(x, y, z, eps);
-  }
-
-  /// Returns the squared norm of this object.
-  HOST DEVICE
-  real squaredNorm() const
-  {
-    return math::sqr(x) + math::sqr(y) + math::sqr(z);
-  }
-
-  /// Returns the length of this object.
-  HOST DEVICE
-  real length() const
-  {
-    return real(sqrt(squaredNorm()));
-  }
-
-  /// Returns the maximum coordinate of this object.
-  HOST DEVICE
-  real max() const
-  {
-    return std::max(x, std::max(y, z));
-  }
-
-  /// Returns the minimum coordinate of this object.
-  HOST DEVICE
-  real min() const
-  {
-    return std::min(x, std::min(y, z));
-  }
-
-  /// Returns the inverse of this object.
-  HOST DEVICE
-  vec3 inverse() const
-  {
-    return vec3{1 / x, 1 / y, 1 / z};
-  }
-
-  /// Inverts and returns a reference to this object.
-  HOST DEVICE
-  vec3& invert()
-  {
-    x = 1 / x;
-    y = 1 / y;
-    z = 1 / z;
-    return *this;
-  }
-
-  /// Negates and returns a reference to this object.
-  HOST DEVICE
-  vec3& negate()
-  {
-    x = -x;
-    y = -y;
-    z = -z;
-    return *this;
-  }
-
-  /// Normalizes and returns a reference to this object.
-  HOST DEVICE
-  vec3& normalize(real eps = math::Limits<real>::eps())
-  {
-    const auto len = length();
-
-    if (!math::isZero(len, eps))
-      operator *=(math::inverse(len));
-    return *this;
-  }
-
-  /// Returns the unit vector of this this object.
-  HOST DEVICE
-  vec3 versor(real eps = math::Limits<real>::eps()) const
-  {
-    return vec3(*this).normalize(eps);
-  }
-
-  /// Returns the unit vector of v.
-  HOST DEVICE
-  static vec3 versor(const vec3& v, real eps = math::Limits<real>::eps())
-  {
-    return v.versor(eps);
-  }
-
-  /// Returns the dot product of this object and v.
-  HOST DEVICE
-  real dot(const vec3& v) const
-  {
-    return x * v.x + y * v.y + z * v.z;
-  }
-
   /// Returns the dot product of this object and (x, y, z).
   HOST DEVICE
-  real dot(real x, real y, real z) const
+  constexpr real dot(real x, real y, real z) const
   {
     return dot(vec3{x, y, z});
   }
 
-  /// Returns the dot product of v and w.
-  HOST DEVICE
-  static real dot(const vec3& v, const vec3& w)
-  {
-    return v.dot(w);
-  }
-
   /// Returns the cross product of this object and v.
   HOST DEVICE
-  vec3 cross(const vec3& v) const
+  constexpr vec3 cross(const vec3& v) const
   {
     const auto cx = y * v.z - z * v.y;
     const auto cy = z * v.x - x * v.z;
@@ -405,14 +168,14 @@ public:
 
   /// Returns the cross product of this object and (x, y, z).
   HOST DEVICE
-  vec3 cross(real x, real y, real z) const
+  constexpr vec3 cross(real x, real y, real z) const
   {
     return cross(vec3{x, y, z});
   }
 
   /// Returns the cross product of v and w.
   HOST DEVICE
-  static vec3 cross(const vec3& v, const vec3& w)
+  static constexpr vec3 cross(const vec3& v, const vec3& w)
   {
     return v.cross(w);
   }
@@ -424,14 +187,6 @@ public:
 
 }; // Vector3
 
-/// Returns the scalar multiplication of s and v.
-template <typename real>
-HOST DEVICE inline Vector3<real>
-operator *(double s, const Vector3<real>& v)
-{
-  return v * real(s);
-}
-
 using vec3f = cg::Vector3<float>;
 using vec3d = cg::Vector3<double>;
 
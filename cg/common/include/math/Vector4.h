@@ -33,6 +33,7 @@
 #ifndef __Vector4_h
 #define __Vector4_h
 
+#include "math/SIMD.h"
 #include "math/Vector3.h"
 
 namespace cg
@@ -44,17 +45,18 @@ namespace cg
 // Vector4: 4D vector class
 // =======
 template <typename real>
-class Vector4
+class Vector4: public Vector<real, 4>
 {
 public:
+  using Vector<real, 4>::x;
+  using Vector<real, 4>::y;
+  using Vector<real, 4>::z;
+  using Vector<real, 4>::w;
+  using Vector<real, 4>::set;
+  using Vector<real, 4>::dot;
+
   using vec3 = Vector3<real>;
   using vec4 = Vector4<real>;
-  using value_type = real;
-
-  real x;
-  real y;
-  real z;
-  real w;
 
   /// Default constructor.
   HOST DEVICE
@@ -62,54 +64,55 @@ public:
 
   /// Constructs a Vector4 object from (x, y, z, w).
   HOST DEVICE
-  Vector4(real x, real y, real z, real w = 0)
+  constexpr Vector4(real x, real y, real z, real w = 0):
+    Vector<real, 4>{x, y, z, w}
   {
-    set(x, y, z, w);
+    // do nothing
   }
 
   /// Constructs a Vector4 object from v[4].
   HOST DEVICE
-  explicit Vector4(const real v[])
+  constexpr explicit Vector4(const real v[]):
+    Vector<real, 4>{v[0], v[1], v[2], v[3]}
   {
-    set(v);
+    // do nothing
   }
 
   /// Constructs a Vector4 object with (s, s, s, s).
   HOST DEVICE
-  explicit Vector4(real s)
+  constexpr explicit Vector4(real s):
+    Vector<real, 4>{s, s, s, s}
   {
-    set(s);
+    // do nothing
   }
 
   /// Constructs a Vector4 object from (v, w).
   HOST DEVICE
-  explicit Vector4(const vec3& v, real w = 0)
+  constexpr explicit Vector4(const vec3& v, real w = 0):
+    Vector<real, 4>{v.x, v.y, v.z, w}
   {
-    set(v, w);
+    // do nothing
   }
 
   /// Constructs a Vector4 object from v.
   HOST DEVICE
   template <typename V>
-  explicit Vector4(const V& v):
-    x{real(v.x)},
-    y{real(v.y)},
-    z{real(v.z)},
-    w{real(v.w)}
+  constexpr explicit Vector4(const V& v):
+    Vector<real, 4>{real(v.x), real(v.y), real(v.z), real(v.w)}
   {
     // do nothing
   }
 
   /// Sets this object to v.
   HOST DEVICE
-  void set(const vec4& v)
+  constexpr void set(const vec4& v)
   {
     *this = v;
   }
 
   /// Sets the coordinates of this object to (x, y, z, w).
   HOST DEVICE
-  void set(real x, real y, real z, real w = 0)
+  constexpr void set(real x, real y, real z, real w = 0)
   {
     this->x = x;
     this->y = y;
@@ -117,26 +120,9 @@ public:
     this->w = w;
   }
 
-  /// Sets the coordinates of this object to v[4].
-  HOST DEVICE
-  void set(const real v[])
-  {
-    x = v[0];
-    y = v[1];
-    z = v[2];
-    w = v[3];
-  }
-
-  /// Sets the coordinates of this object to (s, s, s, s).
-  HOST DEVICE
-  void set(real s)
-  {
-    x = y = z = w = s;
-  }
-
   /// Sets the coordinates of this object to (v, w).
   HOST DEVICE
-  void set(const vec3& v, real w = 0)
+  constexpr void set(const vec3& v, real w = 0)
   {
     x = v.x;
     y = v.y;
@@ -147,271 +133,156 @@ public:
   /// Sets the coordinates of this object from v.
   HOST DEVICE
   template <typename V>
-  void set(const V& v)
+  constexpr void set(const V& v)
   {
     set(real(v.x), real(v.y), real(v.z), real(v.w));
   }
 
   HOST DEVICE
   template <typename V>
-  vec4& operator =(const V& v)
+  constexpr vec4& operator =(const V& v)
   {
     set(v);
     return *this;
   }
 
-  /// Returns a null vector.
-  HOST DEVICE
-  static vec4 null()
-  {
-    return vec4(real(0));
-  }
-
-  /// Returns true if this object is equal to v.
-  HOST DEVICE
-  bool equals(const vec4& v, real eps = math::Limits<real>::eps()) const
-  {
-    return math::isNull(x - v.x, y - v.y, z - v.z, w - v.w, eps);
-  }
-
-  HOST DEVICE
-  bool operator ==(const vec4& v) const
-  {
-    return equals(v);
-  }
-
-  /// Returns true if this object is not equal to v.
-  HOST DEVICE
-  bool operator !=(const vec4& v) const
-  {
-    return !operator ==(v);
-  }
-
-  /// Returns a reference to this object += v.
-  HOST DEVICE
-  vec4& operator +=(const vec4& v)
-  {
-    x += v.x;
-    y += v.y;
-    z += v.z;
-    w += v.w;
-    return *this;
-  }
-
-  /// Returns a reference to this object -= v.
-  HOST DEVICE
-  vec4& operator -=(const vec4& v)
-  {
-    x -= v.x;
-    y -= v.y;
-    z -= v.z;
-    w -= v.w;
-    return *this;
-  }
-
-  /// Returns a reference to this object *= s.
-  HOST DEVICE
-  vec4& operator *=(real s)
-  {
-    x *= s;
-    y *= s;
-    z *= s;
-    w *= s;
-    return *this;
-  }
-
-  /// Returns a reference to this object *= v.
-  HOST DEVICE
-  vec4& operator *=(const vec4& v)
-  {
-    x *= v.x;
-    y *= v.y;
-    z *= v.z;
-    w *= v.w;
-    return *this;
-  }
-
-  /// Returns a reference to the i-th coordinate of this object.
-  HOST DEVICE
-  real& operator [](int i)
-  {
-    return (&x)[i];
-  }
-
-  /// Returns the i-th coordinate of this object.
-  HOST DEVICE
-  const real& operator [](int i) const
-  {
-    return (&x)[i];
-  }
-
-  /// Returns a pointer to the elements of this object.
-  HOST DEVICE
-  explicit operator const real*() const
-  {
-    return &x;
-  }
-
-  /// Returns this object + v.
-  HOST DEVICE
-  vec4 operator +(const vec4& v) const
-  {
-    return vec4{x + v.x, y + v.y, z + v.z, w + v.w};
-  }
-
-  /// Returns this object - v.
-  HOST DEVICE
-  vec4 operator -(const vec4& v) const
-  {
-    return vec4{x - v.x, y - v.y, z - v.z, w - v.w};
-  }
-
-  /// Returns a vector in the direction opposite to this object.
+  /// Returns the dot product of this object and (x, y, z, w).
   HOST DEVICE
-  vec4 operator -() const
+  constexpr real dot(real x, real y, real z, real w) const
   {
-    return vec4{-x, -y, -z, -w};
+    return dot(vec4{x, y, z, w});
   }
 
-  /// Returns the scalar multiplication of this object and s.
-  HOST DEVICE
-  vec4 operator *(real s) const
+  void print(const char* s, FILE* f = stdout) const
   {
-    return vec4{x * s, y * s, z * s, w * s};
+    fprintf(f, "%s<%g,%g,%g,%g>\n", s, x, y, z, w);
   }
 
-  /// Returns the multiplication of this object and v.
-  HOST DEVICE
-  vec4 operator *(const vec4& v) const
-  {
-    return vec4{x * v.x, y * v.y, z * v.z, w * v.w};
-  }
+}; // Vector4
 
-  /// Returns true if this object is null.
-  HOST DEVICE
-  bool isNull(real eps = math::Limits<real>::eps()) const
-  {
-    return math::isNull(x, y, z, w, eps);
-  }
+#ifdef DS_USE_SSE
 
-  /// Returns the squared norm of this object.
-  HOST DEVICE
-  real squaredNorm() const
-  {
-    return math::sqr(x) + math::sqr(y) + math::sqr(z) + math::sqr(w);
-  }
+namespace simd
+{ // begin namespace simd
 
-  /// Returns the length of this object.
-  HOST DEVICE
-  real length() const
-  {
-    return sqrt(squaredNorm());
-  }
+/// Loads v into an SSE register.
+inline __m128
+load(const Vector<float, 4>& v)
+{
+  return _mm_loadu_ps(&v.x);
+}
 
-  /// Returns the maximum coordinate of this object.
-  HOST DEVICE
-  real max() const
-  {
-    return std::max(x, std::max(y, std::max(z, w)));
-  }
+/// Stores the SSE register r into v.
+inline void
+store(Vector<float, 4>& v, __m128 r)
+{
+  _mm_storeu_ps(&v.x, r);
+}
 
-  /// Returns the minimum coordinate of this object.
-  HOST DEVICE
-  real min() const
-  {
-    return std::min(x, std::min(y, std::min(z, w)));
-  }
+/// Returns the SSE register r as a Vector4.
+inline Vector4<float>
+toVector4(__m128 r)
+{
+  Vector4<float> v;
 
-  /// Returns the inverse of this object.
-  HOST DEVICE
-  vec4 inverse() const
-  {
-    return vec4{1 / x, 1 / y, 1 / z, 1 / w};
-  }
+  _mm_storeu_ps(&v.x, r);
+  return v;
+}
 
-  /// Inverts and returns a reference to this object.
-  HOST DEVICE
-  vec3& invert()
-  {
-    x = 1 / x;
-    y = 1 / y;
-    z = 1 / z;
-    w = 1 / w;
-    return *this;
-  }
+/// Returns the SSE register with all the elements equal to the i-th
+/// element of r.
+template <int i>
+inline __m128
+splat(__m128 r)
+{
+  return _mm_shuffle_ps(r, r, _MM_SHUFFLE(i, i, i, i));
+}
 
-  /// Negates and returns a reference to this object.
-  HOST DEVICE
-  vec4& negate()
-  {
-    x = -x;
-    y = -y;
-    z = -z;
-    w = -w;
-    return *this;
-  }
+/// Returns the SSE register with all the elements equal to the sum of
+/// the elements of r.
+inline __m128
+sum(__m128 r)
+{
+  r = _mm_add_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_add_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 0, 3, 2)));
+}
 
-  /// Normalizes and returns a reference to this object.
-  HOST DEVICE
-  vec4& normalize(real eps = math::Limits<real>::eps())
-  {
-    const auto len = length();
+} // end namespace simd
 
-    if (!math::isZero(len, eps))
-      operator *=(math::inverse(len));
-    return *this;
-  }
+//
+// Vector4<float> specializations (see Matrix4x4.h for the matrices).
+// Unlike the generic members, they are not constexpr
+//
+template <>
+inline Vector4<float>&
+Vector<float, 4>::operator +=(const vec& v)
+{
+  simd::store(*this, _mm_add_ps(simd::load(*this), simd::load(v)));
+  return static_cast<vec&>(*this);
+}
 
-  /// Returns the unit vector of this this object.
-  HOST DEVICE
-  vec4 versor(real eps = math::Limits<real>::eps()) const
-  {
-    return vec4(*this).normalize(eps);
-  }
+template <>
+inline Vector4<float>&
+Vector<float, 4>::operator -=(const vec& v)
+{
+  simd::store(*this, _mm_sub_ps(simd::load(*this), simd::load(v)));
+  return static_cast<vec&>(*this);
+}
 
-  /// Returns the unit vector of v.
-  HOST DEVICE
-  static vec4 versor(const vec4& v, real eps = math::Limits<real>::eps())
-  {
-    return v.versor(eps);
-  }
+template <>
+inline Vector4<float>&
+Vector<float, 4>::operator *=(float s)
+{
+  simd::store(*this, _mm_mul_ps(simd::load(*this), _mm_set1_ps(s)));
+  return static_cast<vec&>(*this);
+}
 
-  /// Returns the dot product of this object and v.
-  HOST DEVICE
-  real dot(const vec4& v) const
-  {
-    return x * v.x + y * v.y + z * v.z + w * v.w;
-  }
+template <>
+inline Vector4<float>&
+Vector<float, 4>::operator *=(const vec& v)
+{
+  simd::store(*this, _mm_mul_ps(simd::load(*this), simd::load(v)));
+  return static_cast<vec&>(*this);
+}
 
-  /// Returns the dot product of this object and (x, y, z, w).
-  HOST DEVICE
-  real dot(real x, real y, real z, real w) const
-  {
-    return dot(vec4(x, y, z, w));
-  }
+template <>
+inline Vector4<float>
+Vector<float, 4>::operator +(const vec& v) const
+{
+  return simd::toVector4(_mm_add_ps(simd::load(*this), simd::load(v)));
+}
 
-  /// Returns the dot product of v and w.
-  HOST DEVICE
-  static real dot(const vec4& v, const vec4& w)
-  {
-    return v.dot(w);
-  }
+template <>
+inline Vector4<float>
+Vector<float, 4>::operator -(const vec& v) const
+{
+  return simd::toVector4(_mm_sub_ps(simd::load(*this), simd::load(v)));
+}
 
-  void print(const char* s, FILE* f = stdout) const
-  {
-    fprintf(f, "%s<%g,%g,%g,%g>\n", s, x, y, z, w);
-  }
+template <>
+inline Vector4<float>
+Vector<float, 4>::operator *(float s) const
+{
+  return simd::toVector4(_mm_mul_ps(simd::load(*this), _mm_set1_ps(s)));
+}
 
-}; // Vector4
+template <>
+inline Vector4<float>
+Vector<float, 4>::operator *(const vec& v) const
+{
+  return simd::toVector4(_mm_mul_ps(simd::load(*this), simd::load(v)));
+}
 
-/// Returns the scalar multiplication of s and v.
-template <typename real>
-HOST DEVICE inline Vector4<real>
-operator *(double s, const Vector4<real>& v)
+template <>
+inline float
+Vector<float, 4>::dot(const vec& v) const
 {
-  return v * real(s);
+  const auto r = simd::sum(_mm_mul_ps(simd::load(*this), simd::load(v)));
+  return _mm_cvtss_f32(r);
 }
 
+#endif // DS_USE_SSE
+
 using vec4f = cg::Vector4<float>;
 using vec4d = cg::Vector4<double>;
 
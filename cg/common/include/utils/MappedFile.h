@@ -0,0 +1,104 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: MappedFile.h
+// ========
+// Class definition for memory-mapped file.
+//
+// Last revision: 18/10/2026
+
+#ifndef __MappedFile_h
+#define __MappedFile_h
+
+#include <cstddef>
+
+namespace cg
+{ // begin namespace cg
+
+
+//////////////////////////////////////////////////////////
+//
+// MappedFile: memory-mapped file class
+// ==========
+class MappedFile
+{
+public:
+  /// Maps the whole contents of the file named \c filename. If
+  /// \c copyOnWrite is true, the mapped pages can be written; the
+  /// changes are private to this object and never reach the file.
+  MappedFile(const char* filename, bool copyOnWrite = false);
+
+  /// Destructor.
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator =(const MappedFile&) = delete;
+
+  /// Returns true if the file has been opened.
+  bool isOpen() const
+  {
+    return _isOpen;
+  }
+
+  /// Returns a pointer to the first byte of the file.
+  const char* data() const
+  {
+    return _data;
+  }
+
+  /// Returns the size in bytes of the file.
+  size_t size() const
+  {
+    return _size;
+  }
+
+  /// Returns a pointer to the first byte of a copy-on-write file.
+  char* data()
+  {
+    return _data;
+  }
+
+  /// Returns a pointer past the last byte of the file.
+  const char* end() const
+  {
+    return _data + _size;
+  }
+
+private:
+  char* _data{};
+  size_t _size{};
+  bool _isOpen{};
+#ifdef _WIN32
+  void* _file;
+  void* _mapping{};
+#else
+  int _file;
+#endif
+
+}; // MappedFile
+
+} // end namespace cg
+
+#endif // __MappedFile_h
@@ -0,0 +1,147 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: MeshCache.h
+// ========
+// Class definition for binary mesh cache.
+//
+// Last revision: 18/10/2026
+
+#ifndef __MeshCache_h
+#define __MeshCache_h
+
+#include "geometry/TriangleMesh.h"
+
+namespace cg
+{ // begin namespace cg
+
+
+//////////////////////////////////////////////////////////
+//
+// MeshCache: binary mesh cache class
+// =========
+//
+// A mesh cache file is a little-endian image of TriangleMesh::Data:
+// a header followed by the vertex, normal, uv and triangle sections,
+// the meshlet and meshlet vertex sections, the table of levels of
+// detail and the vertex, normal, uv and triangle sections of each
+// level of detail, each one aligned to 64 bytes. The file is
+// memory-mapped when read, so that the mesh arrays point straight into
+// the mapped pages.
+//
+class MeshCache
+{
+public:
+  static constexpr uint32_t version = 2;
+  static constexpr uint32_t alignment = 64;
+
+  /// Extension of a cache file, appended to the source file name.
+  static constexpr const char* extension = ".cgm";
+
+  enum Flags : uint32_t
+  {
+    HasUV = 1
+  };
+
+  enum Section
+  {
+    Vertices,
+    Normals,
+    UV,
+    Triangles,
+    MeshletInfo,
+    MeshletVertices,
+    LODInfo,
+    NumberOfSections
+  };
+
+  /// Number of sections of the data of a mesh.
+  static constexpr int numberOfMeshSections = Triangles + 1;
+
+  struct Header
+  {
+    char magic[4];
+    uint32_t version;
+    uint32_t flags;
+    int32_t numberOfVertices;
+    int32_t numberOfTriangles;
+    int32_t numberOfMeshlets;
+    int32_t numberOfMeshletVertices;
+    int32_t numberOfLODs;
+    uint32_t headerSize;
+    uint64_t fileSize;
+    // Size and modification time of the source file, if any
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    // Hash of the sections
+    uint64_t contentHash;
+    uint64_t offsets[NumberOfSections];
+    float bounds[6];
+
+  }; // Header
+
+  // Entry of the table of levels of detail
+  struct LOD
+  {
+    uint32_t flags;
+    int32_t numberOfVertices;
+    int32_t numberOfTriangles;
+    float error;
+    uint64_t offsets[numberOfMeshSections];
+    float bounds[6];
+
+  }; // LOD
+
+  /// Writes the data, levels of detail and meshlets of mesh, which
+  /// (as well as its levels of detail) must have vertex normals, into
+  /// the cache file named \c filename. If \c source is not null, the
+  /// size and modification time of the file named \c source are
+  /// recorded, and the cache is considered stale whenever they change.
+  static bool write(const TriangleMesh& mesh,
+    const char* filename,
+    const char* source = nullptr);
+
+  /// Maps the cache file named \c filename and returns a mesh whose
+  /// arrays, as well as those of its levels of detail, point into the
+  /// mapped file (the meshlets, if any, are copied). Returns null if
+  /// the file does not exist, is invalid or is stale with respect to
+  /// \c source. The sections must lie within the file, and the bounds
+  /// and vertex indices must be valid. If \c verify is true, the content
+  /// hash is checked as well (which touches every page of the file).
+  static TriangleMesh* read(const char* filename,
+    const char* source = nullptr,
+    bool verify = false);
+
+  /// Reads the header of the cache file named \c filename.
+  static bool readHeader(const char* filename, Header& header);
+
+  /// Returns the 64-bit hash of size bytes starting at data.
+  static uint64_t hash(const void* data, size_t size, uint64_t seed = 0);
+
+}; // MeshCache
+
+} // end namespace cg
+
+#endif // __MeshCache_h
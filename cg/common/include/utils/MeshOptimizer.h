@@ -0,0 +1,109 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: MeshOptimizer.h
+// ========
+// Class definition for mesh optimizer.
+//
+// Last revision: 18/10/2026
+
+#ifndef __MeshOptimizer_h
+#define __MeshOptimizer_h
+
+#include "geometry/TriangleMesh.h"
+
+namespace cg
+{ // begin namespace cg
+
+
+//////////////////////////////////////////////////////////
+//
+// MeshOptimizer: mesh optimizer class
+// =============
+class MeshOptimizer
+{
+public:
+  /// Size of the post-transform vertex cache assumed by default.
+  static constexpr int defaultCacheSize = 16;
+  /// Maximum ACMR increase allowed by optimizeOverdraw() by default.
+  static constexpr float defaultOverdrawThreshold = 1.05f;
+
+  /// Statistics of a FIFO post-transform vertex cache.
+  struct VertexCacheStatistics
+  {
+    int cacheSize;
+    int vertexTransforms;
+    // Average cache miss ratio (transforms per triangle, 0.5 to 3)
+    float acmr;
+    // Average transform to vertex ratio (transforms per referenced
+    // vertex, 1 at best)
+    float atvr;
+
+    void print(const char* s, FILE* f = stdout) const;
+
+  }; // VertexCacheStatistics
+
+  /// Simulates drawing the triangles of data with a FIFO vertex cache
+  /// of cacheSize entries.
+  static VertexCacheStatistics analyzeVertexCache(
+    const TriangleMesh::Data& data,
+    int cacheSize = defaultCacheSize);
+
+  /// Reorders the triangles of data for a vertex cache of cacheSize
+  /// entries with the Tipsify algorithm of Sander et al. (2007), which
+  /// runs in linear time.
+  static void optimizeVertexCache(TriangleMesh::Data& data,
+    int cacheSize = defaultCacheSize);
+
+  /// Reorders clusters of triangles of data, as ordered for a vertex
+  /// cache of cacheSize entries, so that the triangles more likely to
+  /// occlude others are drawn first. The triangles are split into
+  /// clusters whose ACMR is at most threshold times the ACMR of the
+  /// input order, which the new order keeps within about threshold.
+  static void optimizeOverdraw(TriangleMesh::Data& data,
+    float threshold = defaultOverdrawThreshold,
+    int cacheSize = defaultCacheSize);
+
+  /// Renumbers the vertices of data in the order they are first used
+  /// by the triangles, moving their normals and uv along. Vertices not
+  /// used by any triangle are kept after the used ones.
+  static void optimizeVertexFetch(TriangleMesh::Data& data);
+
+  /// Applies optimizeVertexCache(), optimizeOverdraw() and
+  /// optimizeVertexFetch() to data, in this order.
+  static void optimize(TriangleMesh::Data& data,
+    float threshold = defaultOverdrawThreshold,
+    int cacheSize = defaultCacheSize);
+
+  /// Optimizes the data of mesh as above.
+  static void optimize(TriangleMesh& mesh,
+    float threshold = defaultOverdrawThreshold,
+    int cacheSize = defaultCacheSize);
+
+}; // MeshOptimizer
+
+} // end namespace cg
+
+#endif // __MeshOptimizer_h
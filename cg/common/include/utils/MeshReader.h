@@ -28,12 +28,13 @@
 // Class definition for mesh reader.
 //
 // Author: Paulo Pagliosa
-// Last revision: 15/09/2018
+// Last revision: 18/10/2026
 
 #ifndef __MeshReader_h
 #define __MeshReader_h
 
 #include "geometry/TriangleMesh.h"
+#include <functional>
 
 namespace cg
 { // begin namespace cg
@@ -46,7 +47,111 @@ namespace cg
 class MeshReader
 {
 public:
-  static TriangleMesh* readOBJ(const char* filename);
+  using Triangle = TriangleMesh::Triangle;
+
+  /// Progress of a mesh read.
+  struct Progress
+  {
+    size_t bytesRead;
+    size_t fileSize;
+    double seconds; // since the read began
+
+    float fraction() const
+    {
+      return fileSize > 0 ? float(double(bytesRead) / fileSize) : 1;
+    }
+
+    /// Returns the parsing throughput in MB/s.
+    double throughput() const
+    {
+      return seconds > 0 ? bytesRead * 1e-6 / seconds : 0;
+    }
+
+  }; // Progress
+
+  /// Function invoked as a read progresses. If it returns false, the
+  /// read is cancelled and the reader returns nullptr. Parallel reads
+  /// may invoke it from any of their threads, but never concurrently.
+  using ProgressCallback = std::function<bool(const Progress&)>;
+
+  /// Receiver of the elements streamed by streamOBJ(). Each call hands
+  /// over count elements whose indices start at first; the pointers
+  /// are valid only during the call.
+  class Sink
+  {
+  public:
+    virtual ~Sink() = default;
+
+    virtual void positions(const vec3f* /*p*/, int /*first*/, int /*count*/)
+    {
+      // do nothing
+    }
+
+    virtual void uv(const vec2f* /*uv*/, int /*first*/, int /*count*/)
+    {
+      // do nothing
+    }
+
+    virtual void normals(const vec3f* /*n*/, int /*first*/, int /*count*/)
+    {
+      // do nothing
+    }
+
+    /// Receives the position, uv and normal indices of count triangles.
+    /// uv (n) is null if no triangle of the batch has uv (normal)
+    /// indices; otherwise, missing indices are -1. Indices refer to
+    /// the elements delivered by positions(), uv() and normals(), which
+    /// may arrive after the triangles that use them.
+    virtual void triangles(const Triangle* /*p*/,
+      const Triangle* /*uv*/,
+      const Triangle* /*n*/,
+      int /*first*/,
+      int /*count*/)
+    {
+      // do nothing
+    }
+
+  }; // Sink
+
+  /// Reads a Wavefront OBJ file. Files larger than about a megabyte
+  /// are split at line boundaries and parsed by numberOfThreads threads
+  /// (all the hardware threads if numberOfThreads <= 0); the resulting
+  /// mesh is the same whatever the number of threads.
+  static TriangleMesh* readOBJ(const char* filename,
+    int numberOfThreads = 0,
+    const ProgressCallback& progress = nullptr);
+
+  /// Reads an ASCII or binary (little or big-endian) PLY file. Only
+  /// the vertex and face elements are read; the vertices can have
+  /// normals (nx, ny, nz) and texture coordinates (u, v or s, t).
+  static TriangleMesh* readPLY(const char* filename,
+    const ProgressCallback& progress = nullptr);
+
+  /// Crease angle, in degrees, of the normals of STL meshes.
+  static constexpr float stlCreaseAngle = 30;
+
+  /// Reads an ASCII or binary STL file. The duplicated vertices of
+  /// the triangles are welded, and split again along the edges sharper
+  /// than stlCreaseAngle (see TriangleMesh::splitCreases()).
+  static TriangleMesh* readSTL(const char* filename,
+    const ProgressCallback& progress = nullptr);
+
+  /// Reads a mesh file whose format (OBJ, PLY or STL) is given by the
+  /// file name extension.
+  static TriangleMesh* read(const char* filename,
+    const ProgressCallback& progress = nullptr);
+
+  /// Returns true if the file name has the extension of a format that
+  /// can be read.
+  static bool isSupported(const char* filename);
+
+  /// Reads a Wavefront OBJ file and delivers its elements to sink in
+  /// batches of at most batchSize elements, in file order. Only one
+  /// batch of each kind is kept in memory at a time, so meshes larger
+  /// than the main memory can be processed.
+  static bool streamOBJ(const char* filename,
+    Sink& sink,
+    int batchSize = 64 * 1024);
 
 }; // MeshReader
 
@@ -0,0 +1,82 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: MeshSimplifier.h
+// ========
+// Class definition for mesh simplifier.
+//
+// Last revision: 18/10/2026
+
+#ifndef __MeshSimplifier_h
+#define __MeshSimplifier_h
+
+#include "geometry/TriangleMesh.h"
+
+namespace cg
+{ // begin namespace cg
+
+
+//////////////////////////////////////////////////////////
+//
+// MeshSimplifier: mesh simplifier class
+// ==============
+class MeshSimplifier
+{
+public:
+  /// Statistics of a simplified mesh.
+  struct Statistics
+  {
+    // Target ratio of the number of triangles of the input mesh
+    float ratio;
+    int numberOfTriangles;
+    // Error of the simplified mesh (see TriangleMesh::LOD)
+    float error;
+    // Time spent simplifying the mesh from the previous level
+    double seconds;
+
+    void print(const char* s, FILE* f = stdout) const;
+
+  }; // Statistics
+
+  /// Returns a copy of mesh simplified by collapsing edges in order of
+  /// quadric error (Garland and Heckbert 1997) until there are at most
+  /// ratio times its triangles or no edge can be collapsed. Normals and
+  /// uv are interpolated along the collapsed edges.
+  static TriangleMesh* simplify(const TriangleMesh& mesh,
+    float ratio,
+    Statistics* statistics = nullptr);
+
+  /// Simplifies mesh to each ratio, from the largest to the smallest,
+  /// and stores the results, optimized for rendering by MeshOptimizer,
+  /// as the levels of detail of mesh. Each level continues simplifying
+  /// the previous one, so all levels take about the time of the last.
+  static std::vector<Statistics> buildLODs(TriangleMesh& mesh,
+    std::vector<float> ratios = {0.5f, 0.25f, 0.125f, 0.0625f});
+
+}; // MeshSimplifier
+
+} // end namespace cg
+
+#endif // __MeshSimplifier_h
@@ -0,0 +1,387 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: BatchQuaternion.cpp
+// ========
+// Source file for batch operations on arrays of quaternions.
+//
+// Last revision: 18/10/2026
+
+#include "core/Parallel.h"
+#include "math/BatchQuaternion.h"
+#include "math/SIMD.h"
+
+namespace cg
+{ // begin namespace cg
+
+namespace internal
+{ // begin namespace internal
+
+// Minimum number of quaternions processed by a thread
+const int minQuaternionRange{64 * 1024};
+
+// Returns -1 if d < 0 and 1 otherwise, the sign of the second
+// quaternion of an interpolation along the shortest arc
+inline float
+arcSign(float d)
+{
+  return d < 0 ? -1.0f : 1.0f;
+}
+
+#ifdef DS_USE_SSE
+
+// Four floats in an SSE register. Quaternion<Float4> and Vector3<Float4>
+// evaluate the scalar methods of quatf and vec3f on four quaternions
+// at a time, with the same operations in the same order.
+struct Float4
+{
+  __m128 v;
+
+  Float4() = default;
+
+  Float4(__m128 v):
+    v{v}
+  {
+    // do nothing
+  }
+
+  Float4(float s):
+    v{_mm_set1_ps(s)}
+  {
+    // do nothing
+  }
+
+}; // Float4
+
+inline Float4
+operator +(Float4 a, Float4 b)
+{
+  return _mm_add_ps(a.v, b.v);
+}
+
+inline Float4
+operator -(Float4 a, Float4 b)
+{
+  return _mm_sub_ps(a.v, b.v);
+}
+
+inline Float4
+operator *(Float4 a, Float4 b)
+{
+  return _mm_mul_ps(a.v, b.v);
+}
+
+inline Float4
+operator /(Float4 a, Float4 b)
+{
+  return _mm_div_ps(a.v, b.v);
+}
+
+inline Float4
+sqrt(Float4 a)
+{
+  return _mm_sqrt_ps(a.v);
+}
+
+inline Float4
+arcSign(Float4 d)
+{
+  const auto m = _mm_cmplt_ps(d.v, _mm_setzero_ps());
+  return _mm_or_ps(_mm_and_ps(m, _mm_set1_ps(-1)),
+    _mm_andnot_ps(m, _mm_set1_ps(1)));
+}
+
+#endif // DS_USE_SSE
+
+// Loads/stores the i-th element (four elements with SSE) of arrays
+inline void
+load(const float* a, int i, float& f)
+{
+  f = a[i];
+}
+
+inline void
+store(float* a, int i, float f)
+{
+  a[i] = f;
+}
+
+#ifdef DS_USE_SSE
+
+inline void
+load(const float* a, int i, Float4& f)
+{
+  f = _mm_loadu_ps(a + i);
+}
+
+inline void
+store(float* a, int i, Float4 f)
+{
+  _mm_storeu_ps(a + i, f.v);
+}
+
+#endif // DS_USE_SSE
+
+template <typename F>
+inline Quaternion<F>
+load(const QuaternionArrays& a, int i)
+{
+  Quaternion<F> q;
+
+  load(a.x, i, q.x);
+  load(a.y, i, q.y);
+  load(a.z, i, q.z);
+  load(a.w, i, q.w);
+  return q;
+}
+
+template <typename F>
+inline void
+store(const QuaternionArrays& a, int i, const Quaternion<F>& q)
+{
+  store(a.x, i, q.x);
+  store(a.y, i, q.y);
+  store(a.z, i, q.z);
+  store(a.w, i, q.w);
+}
+
+// Calls kernel<F>(i) for i in [b, e), with F = Float4 for four
+// elements at a time if SSE is available, and F = float otherwise
+template <typename Kernel>
+inline void
+forEach(int b, int e, const Kernel& kernel)
+{
+  auto i = b;
+
+#ifdef DS_USE_SSE
+  for (; i + 4 <= e; i += 4)
+    kernel(Float4{}, i);
+#endif
+  for (; i < e; ++i)
+    kernel(float{}, i);
+}
+
+template <typename F>
+inline Quaternion<F>
+nlerp(const Quaternion<F>& a, const Quaternion<F>& b, F t)
+{
+  using std::sqrt;
+
+  const auto s = arcSign(a.dot(b));
+  const auto q = a * (1.0f - t) + b * (s * t);
+
+  return q * (1.0f / sqrt(q.squaredNorm()));
+}
+
+// Coefficients of the polynomial approximation of sin(t * theta) /
+// sin(theta) (see fastSlerp()). The last pair is scaled by mu to
+// compensate for the truncation of the series
+constexpr int slerpTerms{12};
+constexpr float slerpMu{1.89371514509f};
+constexpr float slerpU[slerpTerms]
+{
+  1.0f / (1 * 3),
+  1.0f / (2 * 5),
+  1.0f / (3 * 7),
+  1.0f / (4 * 9),
+  1.0f / (5 * 11),
+  1.0f / (6 * 13),
+  1.0f / (7 * 15),
+  1.0f / (8 * 17),
+  1.0f / (9 * 19),
+  1.0f / (10 * 21),
+  1.0f / (11 * 23),
+  slerpMu / (12 * 25)
+};
+constexpr float slerpV[slerpTerms]
+{
+  1.0f / 3,
+  2.0f / 5,
+  3.0f / 7,
+  4.0f / 9,
+  5.0f / 11,
+  6.0f / 13,
+  7.0f / 15,
+  8.0f / 17,
+  9.0f / 19,
+  10.0f / 21,
+  11.0f / 23,
+  slerpMu * 12 / 25
+};
+
+// With x = cos(theta), sin(t * theta) / sin(theta) is the series
+// t * (1 + b1 * (1 + b2 * (1 + ...))), bi = (t^2 - i^2) / (i(2i + 1))
+// * (x - 1), whose terms involve neither trigonometric functions nor
+// divisions
+template <typename F>
+inline Quaternion<F>
+fastSlerp(const Quaternion<F>& a, const Quaternion<F>& b, F t)
+{
+  const auto d = a.dot(b);
+  const auto s = arcSign(d);
+  const auto xm1 = d * s - 1.0f;
+  const auto u = 1.0f - t;
+  const auto tt = t * t;
+  const auto uu = u * u;
+  F ct{1.0f};
+  F cu{1.0f};
+
+  for (int i = slerpTerms; i-- > 0;)
+  {
+    ct = 1.0f + (slerpU[i] * tt - slerpV[i]) * xm1 * ct;
+    cu = 1.0f + (slerpU[i] * uu - slerpV[i]) * xm1 * cu;
+  }
+  return a * (u * cu) + b * (s * t * ct);
+}
+
+} // end namespace internal
+
+void
+toArrays(const quatf* q, const QuaternionArrays& a, int n)
+{
+  for (int i = 0; i < n; ++i)
+  {
+    a.x[i] = q[i].x;
+    a.y[i] = q[i].y;
+    a.z[i] = q[i].z;
+    a.w[i] = q[i].w;
+  }
+}
+
+void
+fromArrays(const QuaternionArrays& a, quatf* q, int n)
+{
+  for (int i = 0; i < n; ++i)
+    q[i].set(a.x[i], a.y[i], a.z[i], a.w[i]);
+}
+
+void
+multiplyQuaternions(const QuaternionArrays& a,
+  const QuaternionArrays& b,
+  const QuaternionArrays& c,
+  int n,
+  int numberOfThreads)
+{
+  parallel::forRange(n, internal::minQuaternionRange, [&](int b_, int e)
+  {
+    internal::forEach(b_, e, [&](auto f, int i)
+    {
+      using F = decltype(f);
+      const auto q = internal::load<F>(a, i) * internal::load<F>(b, i);
+
+      internal::store(c, i, q);
+    });
+  }, numberOfThreads);
+}
+
+void
+rotatePoints(const QuaternionArrays& q,
+  const PointArrays& p,
+  const PointArrays& r,
+  int n,
+  int numberOfThreads)
+{
+  parallel::forRange(n, internal::minQuaternionRange, [&](int b, int e)
+  {
+    internal::forEach(b, e, [&](auto f, int i)
+    {
+      using F = decltype(f);
+      Vector3<F> v;
+
+      internal::load(p.x, i, v.x);
+      internal::load(p.y, i, v.y);
+      internal::load(p.z, i, v.z);
+      v = internal::load<F>(q, i).rotate(v);
+      internal::store(r.x, i, v.x);
+      internal::store(r.y, i, v.y);
+      internal::store(r.z, i, v.z);
+    });
+  }, numberOfThreads);
+}
+
+void
+nlerpQuaternions(const QuaternionArrays& a,
+  const QuaternionArrays& b,
+  const float* t,
+  const QuaternionArrays& c,
+  int n,
+  int numberOfThreads)
+{
+  parallel::forRange(n, internal::minQuaternionRange, [&](int b_, int e)
+  {
+    internal::forEach(b_, e, [&](auto f, int i)
+    {
+      using F = decltype(f);
+      F ti;
+
+      internal::load(t, i, ti);
+      internal::store(c, i, internal::nlerp(internal::load<F>(a, i),
+        internal::load<F>(b, i),
+        ti));
+    });
+  }, numberOfThreads);
+}
+
+void
+slerpQuaternions(const QuaternionArrays& a,
+  const QuaternionArrays& b,
+  const float* t,
+  const QuaternionArrays& c,
+  int n,
+  int numberOfThreads)
+{
+  parallel::forRange(n, internal::minQuaternionRange, [&](int b_, int e)
+  {
+    for (int i = b_; i < e; ++i)
+      internal::store(c, i, quatf::slerp(internal::load<float>(a, i),
+        internal::load<float>(b, i),
+        t[i]));
+  }, numberOfThreads);
+}
+
+void
+fastSlerpQuaternions(const QuaternionArrays& a,
+  const QuaternionArrays& b,
+  const float* t,
+  const QuaternionArrays& c,
+  int n,
+  int numberOfThreads)
+{
+  parallel::forRange(n, internal::minQuaternionRange, [&](int b_, int e)
+  {
+    internal::forEach(b_, e, [&](auto f, int i)
+    {
+      using F = decltype(f);
+      F ti;
+
+      internal::load(t, i, ti);
+      internal::store(c, i, internal::fastSlerp(internal::load<F>(a, i),
+        internal::load<F>(b, i),
+        ti));
+    });
+  }, numberOfThreads);
+}
+
+} // end namespace cg
@@ -0,0 +1,469 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: BatchTransform.cpp
+// ========
+// Source file for batch transformation of points and vectors.
+//
+// Last revision: 18/10/2026
+
+#include "core/Parallel.h"
+#include "math/BatchTransform.h"
+#include "math/SIMD.h"
+
+namespace cg
+{ // begin namespace cg
+
+namespace internal
+{ // begin namespace internal
+
+// Minimum number of elements transformed by a thread
+const int minTransformRange{64 * 1024};
+
+// Minimum size in bytes of an output array written with streaming
+// stores, which do not pollute the caches with data not read soon
+const size_t minStreamSize{8 << 20};
+
+// Returns true if the output q of size bytes should be streamed
+inline bool
+streamOutput(const void* p, const void* q, size_t size)
+{
+  return p != q && size >= minStreamSize;
+}
+
+#ifdef DS_USE_SSE
+
+using simd::splat;
+
+inline bool
+isAligned(const void* p)
+{
+  return (uintptr_t(p) & 15) == 0;
+}
+
+// Stores the xyz floats of the four registers r into the 12 floats of
+// d, with streaming stores if stream is true (d must then be aligned
+// to 16 bytes)
+inline void
+store3(float* d, const __m128 r[4], bool stream)
+{
+  const auto t0 = _mm_shuffle_ps(r[1], r[0], _MM_SHUFFLE(2, 2, 0, 0));
+  const auto t2 = _mm_shuffle_ps(r[2], r[3], _MM_SHUFFLE(0, 0, 2, 2));
+  // x0 y0 z0 x1, y1 z1 x2 y2, z2 x3 y3 z3
+  const auto a = _mm_shuffle_ps(r[0], t0, _MM_SHUFFLE(0, 2, 1, 0));
+  const auto b = _mm_shuffle_ps(r[1], r[2], _MM_SHUFFLE(1, 0, 2, 1));
+  const auto c = _mm_shuffle_ps(t2, r[3], _MM_SHUFFLE(2, 1, 2, 0));
+
+  if (stream)
+  {
+    _mm_stream_ps(d, a);
+    _mm_stream_ps(d + 4, b);
+    _mm_stream_ps(d + 8, c);
+  }
+  else
+  {
+    _mm_storeu_ps(d, a);
+    _mm_storeu_ps(d + 4, b);
+    _mm_storeu_ps(d + 8, c);
+  }
+}
+
+// Columns of an affine transformation as 4-float registers
+struct SSEColumns
+{
+  __m128 c[4];
+
+  SSEColumns(const mat4f& m)
+  {
+    for (int j = 0; j < 4; ++j)
+      c[j] = _mm_setr_ps(m[j].x, m[j].y, m[j].z, 0);
+  }
+
+  SSEColumns(const mat3f& m)
+  {
+    for (int j = 0; j < 3; ++j)
+      c[j] = _mm_setr_ps(m[j].x, m[j].y, m[j].z, 0);
+    c[3] = _mm_setzero_ps();
+  }
+
+  // Returns (c0 * x + c1 * y) + c2 * z, plus c3 if point is true, in
+  // the same order of operations as the scalar code. x, y and z have
+  // their four floats equal to a coordinate.
+  template <bool point>
+  __m128 transform(__m128 x, __m128 y, __m128 z) const
+  {
+    auto r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c[0], x),
+      _mm_mul_ps(c[1], y)),
+      _mm_mul_ps(c[2], z));
+
+    return point ? _mm_add_ps(r, c[3]) : r;
+  }
+
+}; // SSEColumns
+
+// Returns v * (1 / |v|), or v if |v| is zero, as vec3f::normalize()
+inline __m128
+normalize(__m128 v)
+{
+  const auto s = _mm_mul_ps(v, v);
+  const auto len = _mm_sqrt_ss(_mm_add_ss(_mm_add_ss(s,
+    _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1))),
+    _mm_shuffle_ps(s, s, _MM_SHUFFLE(2, 2, 2, 2))));
+
+  if (_mm_cvtss_f32(len) <= math::Limits<float>::eps())
+    return v;
+
+  const auto inv = _mm_div_ss(_mm_set_ss(1), len);
+  return _mm_mul_ps(v, _mm_shuffle_ps(inv, inv, 0));
+}
+
+// Transforms the n elements (points or vectors) of p into q. Four
+// elements (12 floats) are loaded before any of them is stored, so
+// that q can be p
+template <bool point>
+void
+transform(const SSEColumns& m,
+  const vec3f* p,
+  vec3f* q,
+  int n,
+  bool unit,
+  bool stream)
+{
+  auto transform1 = [&](int i)
+  {
+    alignas(16) float v[4];
+
+    _mm_store_ps(v, m.transform<point>(_mm_set1_ps(p[i].x),
+      _mm_set1_ps(p[i].y),
+      _mm_set1_ps(p[i].z)));
+    q[i].set(v[0], v[1], v[2]);
+    if (unit)
+      q[i].normalize();
+  };
+  int i = 0;
+
+  if (stream)
+    for (; i < n && !isAligned(q + i); ++i)
+      transform1(i);
+  for (; i + 4 <= n; i += 4)
+  {
+    auto s = &p[i].x;
+    const auto a = _mm_loadu_ps(s); // x0 y0 z0 x1
+    const auto b = _mm_loadu_ps(s + 4); // y1 z1 x2 y2
+    const auto c = _mm_loadu_ps(s + 8); // z2 x3 y3 z3
+    __m128 r[4];
+
+    r[0] = m.transform<point>(splat<0>(a), splat<1>(a), splat<2>(a));
+    r[1] = m.transform<point>(splat<3>(a), splat<0>(b), splat<1>(b));
+    r[2] = m.transform<point>(splat<2>(b), splat<3>(b), splat<0>(c));
+    r[3] = m.transform<point>(splat<1>(c), splat<2>(c), splat<3>(c));
+    if (unit)
+      for (auto& v : r)
+        v = normalize(v);
+    store3(&q[i].x, r, stream);
+  }
+  for (; i < n; ++i)
+    transform1(i);
+  if (stream)
+    _mm_sfence();
+}
+
+// Transforms the n homogeneous points of p into q
+inline void
+transform(const mat4f& m, const vec4f* p, vec4f* q, int n, bool stream)
+{
+  const __m128 c[4]{
+    simd::load(m[0]),
+    simd::load(m[1]),
+    simd::load(m[2]),
+    simd::load(m[3])};
+
+  if (stream && isAligned(q))
+  {
+    for (int i = 0; i < n; ++i)
+      _mm_stream_ps(&q[i].x, simd::transform(c, simd::load(p[i])));
+    _mm_sfence();
+  }
+  else
+    for (int i = 0; i < n; ++i)
+      simd::store(q[i], simd::transform(c, simd::load(p[i])));
+}
+
+// Returns the point (x, y, z, 1) transformed by the columns c, in the
+// same order of operations as simd::transform()
+inline __m128
+transform(const __m128 c[4], __m128 x, __m128 y, __m128 z)
+{
+  return _mm_add_ps(_mm_add_ps(_mm_mul_ps(c[0], x), _mm_mul_ps(c[1], y)),
+    _mm_add_ps(_mm_mul_ps(c[2], z), c[3]));
+}
+
+// Transforms the n points of p into q by the projective transformation
+// m, dividing by w unless it is zero, as mat4f::transform(const vec3f&)
+void
+project(const mat4f& m, const vec3f* p, vec3f* q, int n, bool stream)
+{
+  const __m128 c[4]{
+    simd::load(m[0]),
+    simd::load(m[1]),
+    simd::load(m[2]),
+    simd::load(m[3])};
+  const auto one = _mm_set1_ps(1);
+  const auto eps = _mm_set1_ps(math::Limits<float>::eps());
+  const auto abs = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  int i = 0;
+
+  if (stream)
+    for (; i < n && !isAligned(q + i); ++i)
+      q[i] = m.transform(p[i]);
+  for (; i + 4 <= n; i += 4)
+  {
+    auto s = &p[i].x;
+    const auto a = _mm_loadu_ps(s); // x0 y0 z0 x1
+    const auto b = _mm_loadu_ps(s + 4); // y1 z1 x2 y2
+    const auto d = _mm_loadu_ps(s + 8); // z2 x3 y3 z3
+    __m128 r[4];
+
+    r[0] = transform(c, splat<0>(a), splat<1>(a), splat<2>(a));
+    r[1] = transform(c, splat<3>(a), splat<0>(b), splat<1>(b));
+    r[2] = transform(c, splat<2>(b), splat<3>(b), splat<0>(d));
+    r[3] = transform(c, splat<1>(d), splat<2>(d), splat<3>(d));
+    _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+
+    // The fourth row has the w of the points
+    const auto zero = _mm_cmple_ps(_mm_and_ps(r[3], abs), eps);
+    const auto w = _mm_or_ps(_mm_and_ps(zero, one), _mm_andnot_ps(zero, r[3]));
+    const auto k = _mm_div_ps(one, w);
+
+    r[0] = _mm_mul_ps(r[0], k);
+    r[1] = _mm_mul_ps(r[1], k);
+    r[2] = _mm_mul_ps(r[2], k);
+    _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+    store3(&q[i].x, r, stream);
+  }
+  for (; i < n; ++i)
+    q[i] = m.transform(p[i]);
+  if (stream)
+    _mm_sfence();
+}
+
+// Transforms in place the n points of the SoA arrays x, y and z
+inline void
+transform(const mat4f& m, float* x, float* y, float* z, int n)
+{
+  __m128 c[4][3];
+
+  for (int j = 0; j < 4; ++j)
+    for (int k = 0; k < 3; ++k)
+      c[j][k] = _mm_set1_ps(m[j][k]);
+
+  int i = 0;
+
+  for (; i + 4 <= n; i += 4)
+  {
+    const auto px = _mm_loadu_ps(x + i);
+    const auto py = _mm_loadu_ps(y + i);
+    const auto pz = _mm_loadu_ps(z + i);
+    __m128 r[3];
+
+    for (int k = 0; k < 3; ++k)
+      r[k] = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(c[0][k], px),
+        _mm_mul_ps(c[1][k], py)),
+        _mm_mul_ps(c[2][k], pz)),
+        c[3][k]);
+    _mm_storeu_ps(x + i, r[0]);
+    _mm_storeu_ps(y + i, r[1]);
+    _mm_storeu_ps(z + i, r[2]);
+  }
+  for (; i < n; ++i)
+  {
+    const auto p = m.transform3x4(vec3f{x[i], y[i], z[i]});
+
+    x[i] = p.x;
+    y[i] = p.y;
+    z[i] = p.z;
+  }
+}
+
+#endif // DS_USE_SSE
+
+} // end namespace internal
+
+void
+transformPoints(const mat4f& m,
+  const vec3f* p,
+  vec3f* q,
+  int n,
+  int numberOfThreads)
+{
+#ifdef DS_USE_SSE
+  const internal::SSEColumns c{m};
+  const auto stream = internal::streamOutput(p, q, sizeof(vec3f) * n);
+#endif
+
+  parallel::forRange(n, internal::minTransformRange, [&](int b, int e)
+  {
+#ifdef DS_USE_SSE
+    internal::transform<true>(c, p + b, q + b, e - b, false, stream);
+#else
+    for (int i = b; i < e; ++i)
+      q[i] = m.transform3x4(p[i]);
+#endif
+  }, numberOfThreads);
+}
+
+void
+transformPoints(const mat4f& m,
+  float* x,
+  float* y,
+  float* z,
+  int n,
+  int numberOfThreads)
+{
+  parallel::forRange(n, internal::minTransformRange, [&](int b, int e)
+  {
+#ifdef DS_USE_SSE
+    internal::transform(m, x + b, y + b, z + b, e - b);
+#else
+    for (int i = b; i < e; ++i)
+    {
+      const auto p = m.transform3x4(vec3f{x[i], y[i], z[i]});
+
+      x[i] = p.x;
+      y[i] = p.y;
+      z[i] = p.z;
+    }
+#endif
+  }, numberOfThreads);
+}
+
+void
+transformPoints(const mat4f& m,
+  const vec4f* p,
+  vec4f* q,
+  int n,
+  int numberOfThreads)
+{
+#ifdef DS_USE_SSE
+  const auto stream = internal::streamOutput(p, q, sizeof(vec4f) * n);
+#endif
+
+  parallel::forRange(n, internal::minTransformRange, [&](int b, int e)
+  {
+#ifdef DS_USE_SSE
+    internal::transform(m, p + b, q + b, e - b, stream);
+#else
+    for (int i = b; i < e; ++i)
+      q[i] = m.transform(p[i]);
+#endif
+  }, numberOfThreads);
+}
+
+void
+projectPoints(const mat4f& m,
+  const vec3f* p,
+  vec3f* q,
+  int n,
+  int numberOfThreads)
+{
+#ifdef DS_USE_SSE
+  const auto stream = internal::streamOutput(p, q, sizeof(vec3f) * n);
+#endif
+
+  parallel::forRange(n, internal::minTransformRange, [&](int b, int e)
+  {
+#ifdef DS_USE_SSE
+    internal::project(m, p + b, q + b, e - b, stream);
+#else
+    for (int i = b; i < e; ++i)
+      q[i] = m.transform(p[i]);
+#endif
+  }, numberOfThreads);
+}
+
+void
+transformVectors(const mat3f& m,
+  const vec3f* v,
+  vec3f* w,
+  int n,
+  bool normalize,
+  int numberOfThreads)
+{
+#ifdef DS_USE_SSE
+  const internal::SSEColumns c{m};
+  const auto stream = internal::streamOutput(v, w, sizeof(vec3f) * n);
+#endif
+
+  parallel::forRange(n, internal::minTransformRange, [&](int b, int e)
+  {
+#ifdef DS_USE_SSE
+    internal::transform<false>(c, v + b, w + b, e - b, normalize, stream);
+#else
+    for (int i = b; i < e; ++i)
+    {
+      w[i] = m * v[i];
+      if (normalize)
+        w[i].normalize();
+    }
+#endif
+  }, numberOfThreads);
+}
+
+#ifdef DS_USE_SSE
+
+//
+// Matrix4x4<float> batch transform specializations
+//
+template <>
+void
+Matrix4x4<float>::transform(const vec4* p, vec4* q, int n) const
+{
+  transformPoints(*this, p, q, n);
+}
+
+template <>
+void
+Matrix4x4<float>::transform(const vec3* p, vec3* q, int n) const
+{
+  projectPoints(*this, p, q, n);
+}
+
+template <>
+void
+Matrix4x4<float>::transform3x4(const vec3* p, vec3* q, int n) const
+{
+  transformPoints(*this, p, q, n);
+}
+
+template <>
+void
+Matrix4x4<float>::transformVector(const vec3* v, vec3* w, int n) const
+{
+  transformVectors(mat3f{*this}, v, w, n);
+}
+
+#endif // DS_USE_SSE
+
+} // end namespace cg
@@ -211,18 +211,17 @@ GLGraphics::drawMesh(TriangleMesh& mesh, const mat4f& t, const mat3f& n)
 {
   auto cp = GLSL::Program::current();
 
+  auto m = glMesh(&mesh);
+
   _meshDrawer.use();
-  _meshDrawer.setUniformMat4(_transformLoc, t);
+  _meshDrawer.setUniformMat4(_transformLoc, t * m->positionMatrix());
   _meshDrawer.setUniformMat3(_normalMatrixLoc, n);
   _meshDrawer.setUniformMat4(_vpMatrixLoc, _vpMatrix);
   _meshDrawer.setUniformVec3(_lightPositionLoc, _lightPosition);
   _meshDrawer.setUniformVec4(_colorLoc, _meshColor);
   _meshDrawer.setUniform(_flatModeLoc, _flatMode);
-
-  auto m = glMesh(&mesh);
-
   m->bind();
-  glDrawElements(GL_TRIANGLES, m->vertexCount(), GL_UNSIGNED_INT, 0);
+  glDrawElements(GL_TRIANGLES, m->vertexCount(), m->indexType(), 0);
   GLSL::Program::setCurrent(cp);
 }
 
@@ -32,6 +32,7 @@
 
 #include "geometry/MeshSweeper.h"
 #include "graphics/GLGraphics3.h"
+#include "math/BatchTransform.h"
 
 namespace cg
 { // begin namespace cg
@@ -221,18 +222,17 @@ GLGraphics3::drawMesh(TriangleMesh& mesh, const mat4f& t, const mat3f& n)
 {
   auto cp = GLSL::Program::current();
 
+  auto m = glMesh(&mesh);
+
   _meshDrawer.use();
-  _meshDrawer.setUniformMat4(_transformLoc, t);
+  _meshDrawer.setUniformMat4(_transformLoc, t * m->positionMatrix());
   _meshDrawer.setUniformMat3(_normalMatrixLoc, n);
   _meshDrawer.setUniformMat4(_vpMatrixLoc, _vpMatrix);
   _meshDrawer.setUniformVec3(_lightPositionLoc, _lightPosition);
   _meshDrawer.setUniformVec4(_colorLoc, _meshColor);
   _meshDrawer.setUniform(_flatModeLoc, _flatMode);
-
-  auto m = glMesh(&mesh);
-
   m->bind();
-  glDrawElements(GL_TRIANGLES, m->vertexCount(), GL_UNSIGNED_INT, 0);
+  glDrawElements(GL_TRIANGLES, m->vertexCount(), m->indexType(), 0);
   GLSL::Program::setCurrent(cp);
 }
 
@@ -276,18 +276,13 @@ GLGraphics3::drawTriangle(const vec3f& p1, const vec3f& p2, const vec3f& p3)
 inline void
 GLGraphics3::drawPolyline(const vec3f* v, int n, const mat4f& m, bool close)
 {
-  auto f = m.transform3x4(v[0]);
-  auto p = f;
+  std::vector<vec3f> p(n);
 
+  m.transform3x4(v, p.data(), n);
   for (int i = 1; i < n; i++)
-  {
-    auto q = m.transform3x4(v[i]);
-
-    drawLine(p, q);
-    p = q;
-  }
-  if (close)
-    drawLine(p, f);
+    drawLine(p[i - 1], p[i]);
+  if (close && n > 0)
+    drawLine(p[n - 1], p[0]);
 }
 
 void
@@ -348,14 +343,16 @@ GLGraphics3::drawNormals(TriangleMesh& mesh, const mat4f& t, const mat3f& n)
 
   if (data.vertexNormals == nullptr)
     return;
-  _flatMode = 1;
-  for (int i = 0; i < data.numberOfVertices; i++)
-  {
-    const auto p = t.transform3x4(data.vertices[i]);
-    const auto N = n.transform(data.vertexNormals[i]).versor();
 
-    drawVector(p, N, 0.5f, glyph);
-  }
+  const auto nv = data.numberOfVertices;
+  std::vector<vec3f> p(nv);
+  std::vector<vec3f> N(nv);
+
+  t.transform3x4(data.vertices, p.data(), nv);
+  transformVectors(n, data.vertexNormals, N.data(), nv, true);
+  _flatMode = 1;
+  for (int i = 0; i < nv; i++)
+    drawVector(p[i], N[i], 0.5f, glyph);
   _flatMode = 0;
 }
 
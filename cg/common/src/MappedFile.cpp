@@ -0,0 +1,143 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: MappedFile.cpp
+// ========
+// Source file for memory-mapped file.
+//
+// Last revision: 18/10/2026
+
+#include "utils/MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cg
+{ // begin namespace cg
+
+
+//////////////////////////////////////////////////////////
+//
+// MappedFile implementation
+// ==========
+#ifdef _WIN32
+
+MappedFile::MappedFile(const char* filename, bool copyOnWrite)
+{
+  _file = CreateFileA(filename,
+    GENERIC_READ,
+    FILE_SHARE_READ,
+    nullptr,
+    OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+    nullptr);
+  if (_file == INVALID_HANDLE_VALUE)
+    return;
+
+  LARGE_INTEGER size;
+
+  if (!GetFileSizeEx(_file, &size))
+    return;
+  _isOpen = true;
+  // An empty file cannot be mapped, but it is still a valid file
+  if ((_size = (size_t)size.QuadPart) == 0)
+    return;
+  _mapping = CreateFileMappingA(_file,
+    nullptr,
+    copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY,
+    0,
+    0,
+    nullptr);
+  if (_mapping != nullptr)
+    _data = (char*)MapViewOfFile(_mapping,
+      copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ,
+      0,
+      0,
+      0);
+  if (_data == nullptr)
+  {
+    _size = 0;
+    _isOpen = false;
+  }
+}
+
+MappedFile::~MappedFile()
+{
+  if (_data != nullptr)
+    UnmapViewOfFile(_data);
+  if (_mapping != nullptr)
+    CloseHandle(_mapping);
+  if (_file != INVALID_HANDLE_VALUE)
+    CloseHandle(_file);
+}
+
+#else
+
+MappedFile::MappedFile(const char* filename, bool copyOnWrite)
+{
+  if ((_file = open(filename, O_RDONLY)) < 0)
+    return;
+
+  struct stat s;
+
+  if (fstat(_file, &s) != 0)
+    return;
+  _isOpen = true;
+  // An empty file cannot be mapped, but it is still a valid file
+  if ((_size = (size_t)s.st_size) == 0)
+    return;
+
+  auto prot = copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+  auto p = mmap(nullptr, _size, prot, MAP_PRIVATE, _file, 0);
+
+  if (p == MAP_FAILED)
+  {
+    _size = 0;
+    _isOpen = false;
+    return;
+  }
+  madvise(p, _size, MADV_SEQUENTIAL);
+  _data = (char*)p;
+}
+
+MappedFile::~MappedFile()
+{
+  if (_data != nullptr)
+    munmap(_data, _size);
+  if (_file >= 0)
+    close(_file);
+}
+
+#endif // _WIN32
+
+} // end namespace cg
@@ -0,0 +1,213 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: MeshAdjacency.cpp
+// ========
+// Source file for triangle mesh adjacency.
+//
+// Last revision: 18/10/2026
+
+#include "core/Parallel.h"
+#include "geometry/MeshAdjacency.h"
+#include <algorithm>
+#include <atomic>
+
+namespace cg
+{ // begin namespace cg
+
+namespace internal
+{ // begin namespace internal
+
+// Minimum number of elements processed by a thread
+const int minAdjacencyRange{16 * 1024};
+
+} // end namespace internal
+
+
+/////////////////////////////////////////////////////////////////////
+//
+// MeshAdjacency implementation
+// =============
+MeshAdjacency::MeshAdjacency(int numberOfVertices,
+  int numberOfTriangles,
+  const int* v,
+  int numberOfThreads):
+  _v{v},
+  _cornerOffsets(numberOfVertices + 1, 0),
+  _vertexCorners(3 * size_t(numberOfTriangles)),
+  _neighborOffsets(numberOfVertices + 1, 0),
+  _twins(3 * size_t(numberOfTriangles))
+{
+  const auto nv = numberOfVertices;
+  const auto nc = 3 * numberOfTriangles;
+  const auto minRange = internal::minAdjacencyRange;
+
+  // Counting sort of the corners by vertex
+  for (int c = 0; c < nc; ++c)
+    ++_cornerOffsets[v[c] + 1];
+  for (int i = 0; i < nv; ++i)
+    _cornerOffsets[i + 1] += _cornerOffsets[i];
+  {
+    std::vector<int> next(_cornerOffsets.begin(), _cornerOffsets.end() - 1);
+
+    for (int c = 0; c < nc; ++c)
+      _vertexCorners[next[v[c]]++] = c;
+  }
+
+  // The half-edges are bucketed by their smallest vertex and sorted by
+  // their largest one, which makes those of an edge adjacent. The twin
+  // of a half-edge is the other one of its edge, if the edge has just
+  // two half-edges with opposite orientations. Degenerate half-edges,
+  // (a, a), have no twin and are not counted as edges
+  auto lo = [v](int c) { return std::min(v[c], v[next(c)]); };
+  auto hi = [v](int c) { return std::max(v[c], v[next(c)]); };
+  std::vector<int> edgeOffsets(nv + 1, 0);
+  std::vector<int> edges(nc);
+  // Index in edges of the first half-edge of the edge of each corner
+  std::vector<int> edgeIds(nc);
+
+  for (int c = 0; c < nc; ++c)
+    ++edgeOffsets[lo(c) + 1];
+  for (int i = 0; i < nv; ++i)
+    edgeOffsets[i + 1] += edgeOffsets[i];
+  {
+    std::vector<int> next(edgeOffsets.begin(), edgeOffsets.end() - 1);
+
+    for (int c = 0; c < nc; ++c)
+      edges[next[lo(c)]++] = c;
+  }
+
+  std::atomic<int> borderEdges{0};
+  std::atomic<int> nonManifoldEdges{0};
+
+  parallel::forRange(nv, minRange, [&](int b, int e)
+  {
+    int borders{0};
+    int nonManifolds{0};
+
+    for (int i = b; i < e; ++i)
+    {
+      const auto first = edges.begin() + edgeOffsets[i];
+      const auto last = edges.begin() + edgeOffsets[i + 1];
+
+      std::sort(first, last, [&](int c, int d)
+      {
+        const auto hc = hi(c);
+        const auto hd = hi(d);
+        return hc < hd || (hc == hd && c < d);
+      });
+      for (auto s = first, t = first; s != last; s = t)
+      {
+        const auto h = hi(*s);
+
+        t = std::find_if(s + 1, last, [&](int c) { return hi(c) != h; });
+
+        const auto id = int(s - edges.begin());
+
+        for (auto p = s; p != t; ++p)
+        {
+          edgeIds[*p] = id;
+          _twins[*p] = -1;
+        }
+        if (h == i)
+          continue;
+        if (t - s == 1)
+          ++borders;
+        else if (t - s == 2 && v[s[0]] != v[s[1]])
+        {
+          _twins[s[0]] = s[1];
+          _twins[s[1]] = s[0];
+        }
+        else
+          ++nonManifolds;
+      }
+    }
+    borderEdges += borders;
+    nonManifoldEdges += nonManifolds;
+  }, numberOfThreads);
+  _borderEdges = borderEdges;
+  _nonManifoldEdges = nonManifoldEdges;
+
+  // The neighbors of each vertex, at most two per corner, are gathered
+  // in a scratch array with room for all of them and then compacted. A
+  // neighbor is added the first time its edge is seen from the vertex,
+  // which is recorded for either end of the edge in its own array, so
+  // that no two threads write the same element
+  std::vector<int> neighbors(2 * size_t(nc));
+  std::vector<char> seenFromLo(nc);
+  std::vector<char> seenFromHi(nc);
+
+  parallel::forRange(nv, minRange, [&](int b, int e)
+  {
+    for (int i = b; i < e; ++i)
+    {
+      const auto n = neighbors.data() + 2 * _cornerOffsets[i];
+      auto k = 0;
+      auto add = [&](int w, int edge)
+      {
+        if (w == i)
+          return;
+
+        auto& seen = i < w ? seenFromLo[edge] : seenFromHi[edge];
+
+        if (!seen)
+        {
+          seen = true;
+          n[k++] = w;
+        }
+      };
+
+      for (auto c : vertexCorners(i))
+      {
+        const auto p = previous(c);
+
+        add(v[next(c)], edgeIds[c]);
+        add(v[p], edgeIds[p]);
+      }
+      _neighborOffsets[i + 1] = k;
+    }
+  }, numberOfThreads);
+  for (int i = 0; i < nv; ++i)
+    _neighborOffsets[i + 1] += _neighborOffsets[i];
+  _neighbors.resize(_neighborOffsets[nv]);
+  parallel::forRange(nv, minRange, [&](int b, int e)
+  {
+    for (int i = b; i < e; ++i)
+      std::copy_n(neighbors.data() + 2 * _cornerOffsets[i],
+        _neighborOffsets[i + 1] - _neighborOffsets[i],
+        _neighbors.data() + _neighborOffsets[i]);
+  }, numberOfThreads);
+}
+
+bool
+MeshAdjacency::isBorderVertex(int v) const
+{
+  for (auto c : vertexCorners(v))
+    if (_twins[c] < 0 || _twins[previous(c)] < 0)
+      return true;
+  return false;
+}
+
+} // end namespace cg
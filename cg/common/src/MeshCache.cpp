@@ -0,0 +1,601 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: MeshCache.cpp
+// ========
+// Source file for binary mesh cache.
+//
+// Last revision: 18/10/2026
+
+#include "utils/MappedFile.h"
+#include "utils/MeshCache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace cg
+{ // begin namespace cg
+
+namespace fs = std::filesystem;
+
+namespace internal
+{ // begin namespace internal
+
+static_assert(sizeof(MeshCache::Header) == 152, "Unexpected header size");
+static_assert(sizeof(MeshCache::LOD) == 72, "Unexpected LOD size");
+static_assert(sizeof(Meshlets::Meshlet) == 48, "Unexpected meshlet size");
+
+static const char meshCacheMagic[4]{'C', 'G', 'M', 'B'};
+
+inline uint64_t
+alignCacheOffset(uint64_t offset)
+{
+  const auto a = uint64_t(MeshCache::alignment);
+  return (offset + a - 1) / a * a;
+}
+
+inline uint64_t
+rotl(uint64_t x, int r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t
+fmix(uint64_t h)
+{
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  return h ^ (h >> 33);
+}
+
+// Source file size and modification time
+inline bool
+sourceStamp(const char* source, uint64_t& size, int64_t& time)
+{
+  std::error_code e;
+  auto s = fs::file_size(source, e);
+
+  if (e)
+    return false;
+
+  auto t = fs::last_write_time(source, e);
+
+  if (e)
+    return false;
+  size = uint64_t(s);
+  time = int64_t(t.time_since_epoch().count());
+  return true;
+}
+
+// Sizes of the sections of the data of a mesh
+inline void
+sectionSizes(int nv, int nt, bool hasUV, uint64_t sizes[])
+{
+  sizes[MeshCache::Vertices] = sizeof(vec3f) * uint64_t(nv);
+  sizes[MeshCache::Normals] = sizes[MeshCache::Vertices];
+  sizes[MeshCache::UV] = hasUV ? sizeof(vec2f) * uint64_t(nv) : 0;
+  sizes[MeshCache::Triangles] = sizeof(TriangleMesh::Triangle) * uint64_t(nt);
+}
+
+// Sizes of the sections described by the header of a cache file
+inline void
+sectionSizes(const MeshCache::Header& h, uint64_t sizes[])
+{
+  sectionSizes(h.numberOfVertices,
+    h.numberOfTriangles,
+    (h.flags & MeshCache::HasUV) != 0,
+    sizes);
+  sizes[MeshCache::MeshletInfo] =
+    sizeof(Meshlets::Meshlet) * uint64_t(h.numberOfMeshlets);
+  sizes[MeshCache::MeshletVertices] =
+    sizeof(int) * uint64_t(h.numberOfMeshletVertices);
+  sizes[MeshCache::LODInfo] =
+    sizeof(MeshCache::LOD) * uint64_t(h.numberOfLODs);
+}
+
+inline bool
+isValidSection(uint64_t offset, uint64_t size, size_t fileSize)
+{
+  return size == 0
+    || (offset % MeshCache::alignment == 0
+    && offset >= sizeof(MeshCache::Header)
+    && offset <= fileSize
+    && size <= fileSize - offset);
+}
+
+inline void
+setCacheBounds(float b[6], const Bounds3f& bounds)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    b[i] = bounds.min()[i];
+    b[i + 3] = bounds.max()[i];
+  }
+}
+
+// Section of a cache file
+struct CacheSection
+{
+  const void* data;
+  uint64_t size;
+  uint64_t offset;
+
+}; // CacheSection
+
+using CacheSections = std::vector<CacheSection>;
+
+// Hash of the sections, chained in file order
+inline uint64_t
+contentHash(const CacheSections& sections)
+{
+  uint64_t h{0};
+
+  for (const auto& s : sections)
+    h = MeshCache::hash(s.data, size_t(s.size), h);
+  return h;
+}
+
+// Lays the non-empty sections of a cache file out one after the other
+struct CacheLayout
+{
+  CacheSections sections;
+  uint64_t fileSize{alignCacheOffset(sizeof(MeshCache::Header))};
+
+  void add(const void* data, uint64_t size, uint64_t& offset)
+  {
+    if (size == 0)
+      return;
+    offset = fileSize;
+    sections.push_back({data, size, offset});
+    fileSize = alignCacheOffset(offset + size);
+  }
+
+  void add(const TriangleMesh::Data& d, uint64_t offsets[])
+  {
+    const void* data[MeshCache::numberOfMeshSections]
+    {
+      d.vertices,
+      d.vertexNormals,
+      d.uv,
+      d.triangles
+    };
+    uint64_t sizes[MeshCache::numberOfMeshSections];
+
+    sectionSizes(d.numberOfVertices,
+      d.numberOfTriangles,
+      d.uv != nullptr,
+      sizes);
+    for (int i = 0; i < MeshCache::numberOfMeshSections; ++i)
+      add(data[i], sizes[i], offsets[i]);
+  }
+
+}; // CacheLayout
+
+// Points the arrays of d into the sections of a mesh in the mapped
+// file. Returns false if the sections are out of the file
+bool
+mapCacheSections(char* base,
+  size_t fileSize,
+  const uint64_t offsets[],
+  uint32_t flags,
+  TriangleMesh::Data& d,
+  CacheSections& sections)
+{
+  if (d.numberOfVertices < 0 || d.numberOfTriangles < 0)
+    return false;
+
+  uint64_t sizes[MeshCache::numberOfMeshSections];
+  void* data[MeshCache::numberOfMeshSections];
+
+  sectionSizes(d.numberOfVertices,
+    d.numberOfTriangles,
+    (flags & MeshCache::HasUV) != 0,
+    sizes);
+  for (int i = 0; i < MeshCache::numberOfMeshSections; ++i)
+  {
+    if (!isValidSection(offsets[i], sizes[i], fileSize))
+      return false;
+    data[i] = nullptr;
+    if (sizes[i] != 0)
+    {
+      data[i] = base + offsets[i];
+      sections.push_back({data[i], sizes[i], offsets[i]});
+    }
+  }
+  d.vertices = (vec3f*)data[MeshCache::Vertices];
+  d.vertexNormals = (vec3f*)data[MeshCache::Normals];
+  d.uv = (vec2f*)data[MeshCache::UV];
+  d.triangles = (TriangleMesh::Triangle*)data[MeshCache::Triangles];
+  return true;
+}
+
+// Checks the ranges of the meshlets of a cache file
+bool
+isValidCacheMeshlets(const MeshCache::Header& h,
+  const Meshlets::Meshlet* meshlets,
+  const int* vertices)
+{
+  for (int i = 0; i < h.numberOfMeshlets; ++i)
+  {
+    const auto& m = meshlets[i];
+
+    if (m.firstTriangle < 0
+      || m.triangleCount < 0
+      || m.triangleCount > h.numberOfTriangles - m.firstTriangle
+      || m.firstVertex < 0
+      || m.vertexCount < 0
+      || m.vertexCount > h.numberOfMeshletVertices - m.firstVertex)
+      return false;
+  }
+  for (int i = 0; i < h.numberOfMeshletVertices; ++i)
+    if (vertices[i] < 0 || vertices[i] >= h.numberOfVertices)
+      return false;
+  return true;
+}
+
+// Checks the bounds and the vertex indices of a mesh of a cache file,
+// whose sections must have been mapped by mapCacheSections()
+bool
+isValidCacheMesh(const TriangleMesh::Data& d, const float bounds[6])
+{
+  if (d.numberOfVertices > 0)
+    for (int i = 0; i < 3; ++i)
+      if (!std::isfinite(bounds[i])
+        || !std::isfinite(bounds[i + 3])
+        || bounds[i] > bounds[i + 3])
+        return false;
+
+  const auto nv = unsigned(d.numberOfVertices);
+  const auto nt = d.numberOfTriangles;
+
+  for (int i = 0; i < nt; ++i)
+  {
+    const auto v = d.triangles[i].v;
+
+    if (unsigned(v[0]) >= nv || unsigned(v[1]) >= nv || unsigned(v[2]) >= nv)
+      return false;
+  }
+  return true;
+}
+
+// Keeps the file mapped while a mesh uses it
+class MeshCacheFile: public SharedObject
+{
+public:
+  MappedFile file;
+
+  MeshCacheFile(const char* filename):
+    file{filename, true}
+  {
+    // do nothing
+  }
+
+}; // MeshCacheFile
+
+bool
+isValidCacheHeader(const MeshCache::Header& h, size_t fileSize)
+{
+  if (memcmp(h.magic, meshCacheMagic, 4) != 0
+    || h.version != MeshCache::version
+    || h.headerSize != sizeof(MeshCache::Header)
+    || h.fileSize != fileSize
+    || h.numberOfVertices < 0
+    || h.numberOfTriangles < 0
+    || h.numberOfMeshlets < 0
+    || h.numberOfMeshletVertices < 0
+    || h.numberOfLODs < 0)
+    return false;
+
+  uint64_t sizes[MeshCache::NumberOfSections];
+
+  sectionSizes(h, sizes);
+  for (int i = 0; i < MeshCache::NumberOfSections; ++i)
+    if (!isValidSection(h.offsets[i], sizes[i], fileSize))
+      return false;
+  return true;
+}
+
+} // end namespace internal
+
+
+//////////////////////////////////////////////////////////
+//
+// MeshCache implementation
+// =========
+uint64_t
+MeshCache::hash(const void* data, size_t size, uint64_t seed)
+{
+  const uint64_t c1{0x87c37b91114253d5ull};
+  const uint64_t c2{0x4cf5ad432745937full};
+  auto p = (const unsigned char*)data;
+  auto h = seed ^ (uint64_t(size) * c1);
+
+  for (auto n = size / 8; n--; p += 8)
+  {
+    uint64_t w;
+
+    memcpy(&w, p, 8);
+    h ^= internal::rotl(w * c1, 31) * c2;
+    h = internal::rotl(h, 27) * 5 + 0x52dce729;
+  }
+  if (auto n = size % 8)
+  {
+    uint64_t w{0};
+
+    memcpy(&w, p, n);
+    h ^= internal::rotl(w * c1, 31) * c2;
+  }
+  return internal::fmix(h);
+}
+
+bool
+MeshCache::write(const TriangleMesh& mesh,
+  const char* filename,
+  const char* source)
+{
+  const auto& d = mesh.data();
+
+  if (d.vertexNormals == nullptr)
+    return false;
+  for (const auto& lod : mesh.lods)
+    if (lod.mesh->data().vertexNormals == nullptr)
+      return false;
+
+  Header header{};
+
+  memcpy(header.magic, internal::meshCacheMagic, 4);
+  header.version = version;
+  header.flags = d.uv != nullptr ? uint32_t(HasUV) : 0u;
+  header.numberOfVertices = d.numberOfVertices;
+  header.numberOfTriangles = d.numberOfTriangles;
+  header.numberOfLODs = int32_t(mesh.lods.size());
+  header.headerSize = sizeof(Header);
+  if (source != nullptr
+    && !internal::sourceStamp(source, header.sourceSize, header.sourceTime))
+    return false;
+
+  std::vector<LOD> lods(mesh.lods.size());
+  internal::CacheLayout layout;
+
+  layout.add(d, header.offsets);
+  if (mesh.meshlets != nullptr && mesh.meshlets->size() > 0)
+  {
+    const auto& meshlets = *mesh.meshlets;
+    const auto& vertices = meshlets.vertices();
+
+    header.numberOfMeshlets = meshlets.size();
+    header.numberOfMeshletVertices = int32_t(vertices.size());
+    layout.add(&meshlets[0],
+      sizeof(Meshlets::Meshlet) * uint64_t(meshlets.size()),
+      header.offsets[MeshletInfo]);
+    layout.add(vertices.data(),
+      sizeof(int) * uint64_t(vertices.size()),
+      header.offsets[MeshletVertices]);
+  }
+  layout.add(lods.data(),
+    sizeof(LOD) * uint64_t(lods.size()),
+    header.offsets[LODInfo]);
+  for (size_t i = 0; i < lods.size(); ++i)
+  {
+    const auto& lod = mesh.lods[i];
+    const auto& ld = lod.mesh->data();
+
+    lods[i].flags = ld.uv != nullptr ? uint32_t(HasUV) : 0u;
+    lods[i].numberOfVertices = ld.numberOfVertices;
+    lods[i].numberOfTriangles = ld.numberOfTriangles;
+    lods[i].error = lod.error;
+    internal::setCacheBounds(lods[i].bounds, lod.mesh->bounds());
+    layout.add(ld, lods[i].offsets);
+  }
+  header.fileSize = layout.fileSize;
+  // The table of levels of detail is complete only now
+  header.contentHash = internal::contentHash(layout.sections);
+  internal::setCacheBounds(header.bounds, mesh.bounds());
+
+  // Write into a temporary file which then replaces the cache, so that
+  // a crash in the middle of the writing never leaves a broken cache
+  auto temp = std::string{filename} + ".tmp";
+  FILE* file;
+
+  if (fopen_s(&file, temp.c_str(), "wb") != 0 || file == nullptr)
+    return false;
+
+  static const char zeros[alignment]{};
+  auto written = fwrite(&header, sizeof(Header), 1, file) == 1;
+  uint64_t position = sizeof(Header);
+
+  for (const auto& s : layout.sections)
+  {
+    if (!written)
+      break;
+
+    auto pad = size_t(s.offset - position);
+
+    written = fwrite(zeros, 1, pad, file) == pad
+      && fwrite(s.data, 1, size_t(s.size), file) == s.size;
+    position = s.offset + s.size;
+  }
+  if (written)
+  {
+    auto pad = size_t(header.fileSize - position);
+    written = fwrite(zeros, 1, pad, file) == pad;
+  }
+  written = fclose(file) == 0 && written;
+
+  std::error_code e;
+
+  if (written)
+    fs::rename(temp, filename, e);
+  if (!written || e)
+  {
+    fs::remove(temp, e);
+    return false;
+  }
+  return true;
+}
+
+bool
+MeshCache::readHeader(const char* filename, Header& header)
+{
+  FILE* file;
+
+  if (fopen_s(&file, filename, "rb") != 0 || file == nullptr)
+    return false;
+
+  auto ok = fread(&header, sizeof(Header), 1, file) == 1;
+
+  fclose(file);
+
+  std::error_code e;
+  auto size = fs::file_size(filename, e);
+
+  return ok && !e && internal::isValidCacheHeader(header, size_t(size));
+}
+
+TriangleMesh*
+MeshCache::read(const char* filename, const char* source, bool verify)
+{
+  Reference<internal::MeshCacheFile> storage{new
+    internal::MeshCacheFile{filename}};
+  auto& file = storage->file;
+
+  if (file.size() < sizeof(Header))
+    return nullptr;
+
+  const auto& header = *(const Header*)file.data();
+
+  if (!internal::isValidCacheHeader(header, file.size()))
+    return nullptr;
+  if (source != nullptr)
+  {
+    uint64_t size;
+    int64_t time;
+
+    if (!internal::sourceStamp(source, size, time)
+      || size != header.sourceSize
+      || time != header.sourceTime)
+      return nullptr;
+  }
+
+  uint64_t sizes[NumberOfSections];
+
+  internal::sectionSizes(header, sizes);
+
+  auto base = file.data();
+  auto section = [&](int i) -> void*
+  {
+    return sizes[i] != 0 ? base + header.offsets[i] : nullptr;
+  };
+  internal::CacheSections sections;
+  TriangleMesh::Data data;
+
+  data.numberOfVertices = header.numberOfVertices;
+  data.numberOfTriangles = header.numberOfTriangles;
+  // The sections of the mesh were checked with the header
+  internal::mapCacheSections(base,
+    file.size(),
+    header.offsets,
+    header.flags,
+    data,
+    sections);
+  if (!internal::isValidCacheMesh(data, header.bounds))
+    return nullptr;
+
+  auto meshletInfo = (const Meshlets::Meshlet*)section(MeshletInfo);
+  auto meshletVertices = (const int*)section(MeshletVertices);
+
+  if (!internal::isValidCacheMeshlets(header, meshletInfo, meshletVertices))
+    return nullptr;
+
+  auto lodInfo = (const LOD*)section(LODInfo);
+  std::vector<TriangleMesh::Data> lodData(header.numberOfLODs);
+
+  for (int i = 0; i < header.numberOfLODs; ++i)
+  {
+    auto& ld = lodData[i];
+
+    ld.numberOfVertices = lodInfo[i].numberOfVertices;
+    ld.numberOfTriangles = lodInfo[i].numberOfTriangles;
+    if (!internal::mapCacheSections(base,
+      file.size(),
+      lodInfo[i].offsets,
+      lodInfo[i].flags,
+      ld,
+      sections)
+      || !internal::isValidCacheMesh(ld, lodInfo[i].bounds))
+      return nullptr;
+  }
+  if (verify)
+  {
+    for (int i = numberOfMeshSections; i < NumberOfSections; ++i)
+      if (sizes[i] != 0)
+        sections.push_back({section(i), sizes[i], header.offsets[i]});
+    // The sections were laid out in file order when hashed
+    std::sort(sections.begin(),
+      sections.end(),
+      [](const internal::CacheSection& a, const internal::CacheSection& b)
+      {
+        return a.offset < b.offset;
+      });
+    if (internal::contentHash(sections) != header.contentHash)
+      return nullptr;
+  }
+
+  // The bounds written by write() are those of the vertices
+  const Bounds3f bounds{vec3f{header.bounds}, vec3f{header.bounds + 3}};
+  auto mesh = new TriangleMesh{data,
+    storage,
+    data.numberOfVertices > 0 ? &bounds : nullptr};
+
+  for (int i = 0; i < header.numberOfLODs; ++i)
+  {
+    const auto& b = lodInfo[i].bounds;
+    const Bounds3f lodBounds{vec3f{b}, vec3f{b + 3}};
+    const auto& ld = lodData[i];
+
+    mesh->lods.push_back({new TriangleMesh{ld,
+      storage,
+      ld.numberOfVertices > 0 ? &lodBounds : nullptr},
+      lodInfo[i].error});
+  }
+  if (header.numberOfMeshlets > 0)
+  {
+    auto meshlets = new Meshlets;
+
+    meshlets->_meshlets.assign(meshletInfo,
+      meshletInfo + header.numberOfMeshlets);
+    meshlets->_vertices.assign(meshletVertices,
+      meshletVertices + header.numberOfMeshletVertices);
+    mesh->meshlets = meshlets;
+  }
+  return mesh;
+}
+
+} // end namespace cg
@@ -0,0 +1,427 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: MeshOptimizer.cpp
+// ========
+// Source file for mesh optimizer.
+//
+// Last revision: 18/10/2026
+
+#include "utils/MeshOptimizer.h"
+#include <algorithm>
+#include <vector>
+
+namespace cg
+{ // begin namespace cg
+
+namespace internal
+{ // begin namespace internal
+
+using Triangle = TriangleMesh::Triangle;
+
+//
+// FIFO post-transform vertex cache. A vertex is in the cache if it is
+// one of the last size vertices transformed
+//
+class VertexCache
+{
+public:
+  VertexCache(int numberOfVertices, int size):
+    _stamps(numberOfVertices, -size),
+    _time{0},
+    _size{size}
+  {
+    // do nothing
+  }
+
+  // Returns the number of vertices of t transformed when drawing t
+  int draw(const Triangle& t)
+  {
+    return transform(t.v[0]) + transform(t.v[1]) + transform(t.v[2]);
+  }
+
+  void clear()
+  {
+    _time += _size;
+  }
+
+private:
+  std::vector<int> _stamps;
+  int _time;
+  int _size;
+
+  int transform(int v)
+  {
+    if (_time - _stamps[v] < _size)
+      return 0;
+    _stamps[v] = _time++;
+    return 1;
+  }
+
+}; // VertexCache
+
+// Vertex to triangle adjacency, as offsets and triangle indices
+void
+buildVertexTriangles(const TriangleMesh::Data& data,
+  std::vector<int>& offsets,
+  std::vector<int>& triangles)
+{
+  const auto nv = data.numberOfVertices;
+  const auto nt = data.numberOfTriangles;
+  const auto t = data.triangles;
+
+  offsets.assign(nv + 1, 0);
+  for (int i = 0; i < nt; ++i)
+    for (auto v : t[i].v)
+      ++offsets[v + 1];
+  for (int i = 0; i < nv; ++i)
+    offsets[i + 1] += offsets[i];
+  triangles.resize(3 * size_t(nt));
+
+  std::vector<int> next(offsets.begin(), offsets.end() - 1);
+
+  for (int i = 0; i < nt; ++i)
+    for (auto v : t[i].v)
+      triangles[next[v]++] = i;
+}
+
+// Starts of the runs of triangles with ACMR at most threshold times the
+// ACMR of the run of triangles beginning at each hard boundary, i.e., a
+// triangle whose vertices are all cache misses
+std::vector<int>
+clusterTriangles(const TriangleMesh::Data& data,
+  float threshold,
+  int cacheSize)
+{
+  const auto nt = data.numberOfTriangles;
+  const auto t = data.triangles;
+  VertexCache cache{data.numberOfVertices, cacheSize};
+  std::vector<int> hard;
+
+  for (int i = 0; i < nt; ++i)
+    if (cache.draw(t[i]) == 3 || i == 0)
+      hard.push_back(i);
+  hard.push_back(nt);
+
+  std::vector<int> clusters;
+
+  for (size_t k = 0; k + 1 < hard.size(); ++k)
+  {
+    const auto b = hard[k];
+    const auto e = hard[k + 1];
+    int misses{0};
+
+    cache.clear();
+    for (int i = b; i < e; ++i)
+      misses += cache.draw(t[i]);
+
+    const auto acmr = threshold * misses / (e - b);
+    auto start = b;
+
+    misses = 0;
+    cache.clear();
+    for (int i = b; i < e; ++i)
+    {
+      misses += cache.draw(t[i]);
+      if (misses <= acmr * (i + 1 - start))
+      {
+        clusters.push_back(start);
+        start = i + 1;
+        misses = 0;
+        cache.clear();
+      }
+    }
+    // The triangles left after the last soft boundary, if any, join the
+    // previous cluster
+    if (start == b)
+      clusters.push_back(b);
+  }
+  clusters.push_back(nt);
+  return clusters;
+}
+
+template <typename T>
+void
+permute(T* a, const std::vector<int>& remap)
+{
+  if (a == nullptr)
+    return;
+
+  std::vector<T> b(a, a + remap.size());
+
+  for (size_t i = 0; i < remap.size(); ++i)
+    a[remap[i]] = b[i];
+}
+
+} // end namespace internal
+
+
+/////////////////////////////////////////////////////////////////////
+//
+// MeshOptimizer implementation
+// =============
+void
+MeshOptimizer::VertexCacheStatistics::print(const char* s, FILE* f) const
+{
+  fprintf(f,
+    "%s: cache size %d, transforms %d, ACMR %.3f, ATVR %.3f\n",
+    s,
+    cacheSize,
+    vertexTransforms,
+    acmr,
+    atvr);
+}
+
+MeshOptimizer::VertexCacheStatistics
+MeshOptimizer::analyzeVertexCache(const TriangleMesh::Data& data,
+  int cacheSize)
+{
+  const auto nt = data.numberOfTriangles;
+  internal::VertexCache cache{data.numberOfVertices, cacheSize};
+  std::vector<bool> used(data.numberOfVertices);
+  int transforms{0};
+  int vertices{0};
+
+  for (int i = 0; i < nt; ++i)
+  {
+    const auto& t = data.triangles[i];
+
+    transforms += cache.draw(t);
+    for (auto v : t.v)
+      if (!used[v])
+      {
+        used[v] = true;
+        ++vertices;
+      }
+  }
+  return
+  {
+    cacheSize,
+    transforms,
+    nt > 0 ? float(transforms) / nt : 0,
+    vertices > 0 ? float(transforms) / vertices : 0
+  };
+}
+
+void
+MeshOptimizer::optimizeVertexCache(TriangleMesh::Data& data, int cacheSize)
+{
+  const auto nv = data.numberOfVertices;
+  const auto nt = data.numberOfTriangles;
+  const auto t = data.triangles;
+
+  if (nt == 0)
+    return;
+
+  std::vector<int> offsets;
+  std::vector<int> adjacency;
+
+  internal::buildVertexTriangles(data, offsets, adjacency);
+
+  // Number of triangles of each vertex not emitted yet
+  std::vector<int> live(nv);
+
+  for (int i = 0; i < nv; ++i)
+    live[i] = offsets[i + 1] - offsets[i];
+
+  // Time each vertex last entered the cache
+  std::vector<int> stamps(nv);
+  std::vector<bool> emitted(nt);
+  std::vector<int> deadEnds;
+  std::vector<int> candidates;
+  std::vector<TriangleMesh::Triangle> triangles;
+  auto time = cacheSize + 1;
+  int cursor{0};
+  int best;
+  int f{0};
+
+  triangles.reserve(nt);
+  for (;;)
+  {
+    // Emit the triangles around the fanning vertex f
+    candidates.clear();
+    for (auto k = offsets[f]; k < offsets[f + 1]; ++k)
+    {
+      const auto i = adjacency[k];
+
+      if (emitted[i])
+        continue;
+      for (auto v : t[i].v)
+      {
+        deadEnds.push_back(v);
+        candidates.push_back(v);
+        --live[v];
+        if (time - stamps[v] > cacheSize)
+          stamps[v] = time++;
+      }
+      emitted[i] = true;
+      triangles.push_back(t[i]);
+    }
+    // The next fanning vertex is the candidate with live triangles
+    // longest in the cache that stays there after being fanned, or
+    // any candidate with live triangles, if any...
+    f = -1;
+    best = -1;
+    for (auto v : candidates)
+      if (live[v] > 0)
+      {
+        const auto age = time - stamps[v];
+        const auto p = age + 2 * live[v] <= cacheSize ? age : 0;
+
+        if (p > best)
+        {
+          best = p;
+          f = v;
+        }
+      }
+    // ...or the last vertex emitted with live triangles, if any...
+    while (f < 0 && !deadEnds.empty())
+    {
+      if (live[deadEnds.back()] > 0)
+        f = deadEnds.back();
+      deadEnds.pop_back();
+    }
+    // ...or the next vertex in input order with live triangles
+    while (f < 0 && cursor < nv)
+      if (live[cursor++] > 0)
+        f = cursor - 1;
+    if (f < 0)
+      break;
+  }
+  std::copy(triangles.begin(), triangles.end(), t);
+}
+
+void
+MeshOptimizer::optimizeOverdraw(TriangleMesh::Data& data,
+  float threshold,
+  int cacheSize)
+{
+  const auto nt = data.numberOfTriangles;
+
+  if (nt == 0)
+    return;
+
+  const auto v = data.vertices;
+  const auto t = data.triangles;
+  const auto clusters = internal::clusterTriangles(data, threshold, cacheSize);
+  const auto nc = int(clusters.size()) - 1;
+  std::vector<vec3f> centers(nc);
+  std::vector<vec3f> normals(nc);
+  vec3f center{0.0f};
+  float area{0};
+
+  // Area weighted centroids and normals of the clusters and the mesh
+  for (int k = 0; k < nc; ++k)
+  {
+    vec3f c{0.0f};
+    vec3f n{0.0f};
+    float a{0};
+
+    for (auto i = clusters[k]; i < clusters[k + 1]; ++i)
+    {
+      const auto& p0 = v[t[i].v[0]];
+      const auto& p1 = v[t[i].v[1]];
+      const auto& p2 = v[t[i].v[2]];
+      const auto N = (p1 - p0).cross(p2 - p0);
+      const auto A = N.length();
+
+      c += (p0 + p1 + p2) * A;
+      n += N;
+      a += A;
+    }
+    center += c;
+    area += a;
+    centers[k] = a > 0 ? c * math::inverse(3 * a) : c;
+    normals[k] = n.versor();
+  }
+  if (area > 0)
+    center *= math::inverse(3 * area);
+
+  // Clusters facing away from the center, which tend to be in front of
+  // the others, are drawn first
+  std::vector<float> keys(nc);
+  std::vector<int> order(nc);
+
+  for (int k = 0; k < nc; ++k)
+  {
+    keys[k] = (centers[k] - center).dot(normals[k]);
+    order[k] = k;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b)
+  {
+    return keys[a] > keys[b];
+  });
+
+  std::vector<TriangleMesh::Triangle> triangles;
+
+  triangles.reserve(nt);
+  for (auto k : order)
+    triangles.insert(triangles.end(),
+      t + clusters[k],
+      t + clusters[k + 1]);
+  std::copy(triangles.begin(), triangles.end(), t);
+}
+
+void
+MeshOptimizer::optimizeVertexFetch(TriangleMesh::Data& data)
+{
+  const auto nv = data.numberOfVertices;
+  const auto nt = data.numberOfTriangles;
+  std::vector<int> remap(nv, -1);
+  int next{0};
+
+  for (int i = 0; i < nt; ++i)
+    for (auto& v : data.triangles[i].v)
+    {
+      if (remap[v] < 0)
+        remap[v] = next++;
+      v = remap[v];
+    }
+  for (auto& i : remap)
+    if (i < 0)
+      i = next++;
+  internal::permute(data.vertices, remap);
+  internal::permute(data.vertexNormals, remap);
+  internal::permute(data.uv, remap);
+}
+
+void
+MeshOptimizer::optimize(TriangleMesh::Data& data,
+  float threshold,
+  int cacheSize)
+{
+  optimizeVertexCache(data, cacheSize);
+  optimizeOverdraw(data, threshold, cacheSize);
+  optimizeVertexFetch(data);
+}
+
+void
+MeshOptimizer::optimize(TriangleMesh& mesh, float threshold, int cacheSize)
+{
+  optimize(mesh.editData(), threshold, cacheSize);
+  mesh.dataChanged(true, false);
+}
+
+} // end namespace cg
@@ -30,8 +30,19 @@
 // Author: Paulo Pagliosa
 // Last revision: 05/09/2019
 
+#include "core/Parallel.h"
+#include "utils/MappedFile.h"
 #include "utils/MeshReader.h"
-#include <filesystem>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace cg
 { // begin namespace cg
@@ -39,191 +50,1702 @@ namespace cg
 namespace internal
 { // begin namespace internal
 
-void
-readMeshSize(FILE* file, TriangleMesh::Data& data)
+//
+// Growable array whose storage can be handed over to a TriangleMesh
+//
+template <typename T>
+class Buffer
 {
-  const unsigned int lineSize{128};
-  int nv{};
-  int nt{};
+public:
+  Buffer() = default;
+
+  Buffer(const Buffer&) = delete;
+  Buffer& operator =(const Buffer&) = delete;
+
+  ~Buffer()
+  {
+    delete []_data;
+  }
+
+  int size() const
+  {
+    return _size;
+  }
+
+  T* data() const
+  {
+    return _data;
+  }
+
+  T& operator [](int i)
+  {
+    return _data[i];
+  }
 
-  for (char line[lineSize]; fscanf_s(file, "%s", line, lineSize) != EOF;)
-    switch (line[0])
+  void reserve(int capacity)
+  {
+    if (capacity <= _capacity)
+      return;
+
+    auto data = new T[capacity];
+
+    if (_size > 0)
+      memcpy(data, _data, _size * sizeof(T));
+    delete []_data;
+    _data = data;
+    _capacity = capacity;
+  }
+
+  void resize(int size)
+  {
+    reserve(size);
+    _size = size;
+  }
+
+  void clear()
+  {
+    _size = 0;
+  }
+
+  T& add()
+  {
+    if (_size == _capacity)
+      reserve(_capacity < 1024 ? 1024 : _capacity * 2);
+    return _data[_size++];
+  }
+
+  /// Returns the elements shrunk to fit and detaches them from this buffer.
+  T* release()
+  {
+    if (_size == 0)
     {
-      case 'v':
-        if (line[1] == '\0')
-            nv++;
-        fgets(line, lineSize, file);
-        break;
+      delete []_data;
+      _data = nullptr;
+    }
+    else if (_size < _capacity)
+    {
+      auto data = new T[_size];
+
+      memcpy(data, _data, _size * sizeof(T));
+      delete []_data;
+      _data = data;
+    }
+
+    auto data = _data;
+
+    _data = nullptr;
+    _size = _capacity = 0;
+    return data;
+  }
+
+private:
+  T* _data{};
+  int _size{};
+  int _capacity{};
+
+}; // Buffer
 
-      case 'f':
+inline bool
+isDigit(char c)
+{
+  return unsigned(c - '0') < 10u;
+}
+
+inline bool
+isBlank(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline const char*
+skipBlanks(const char* s, const char* end)
+{
+  while (s < end && isBlank(*s))
+    ++s;
+  return s;
+}
+
+inline const char*
+skipToken(const char* s, const char* end)
+{
+  while (s < end && !isBlank(*s) && *s != '\n')
+    ++s;
+  return s;
+}
+
+/// Returns a pointer to the first character of the next line.
+inline const char*
+skipLine(const char* s, const char* end)
+{
+  auto eol = (const char*)memchr(s, '\n', end - s);
+  return eol == nullptr ? end : eol + 1;
+}
+
+inline bool
+parseInt(const char*& s, const char* end, int& value)
+{
+  auto p = s;
+  auto negative = false;
+
+  if (p < end && (*p == '-' || *p == '+'))
+    negative = *p++ == '-';
+  if (p == end || !isDigit(*p))
+    return false;
+
+  int i{0};
+
+  for (; p < end && isDigit(*p); ++p)
+  {
+    const auto d = *p - '0';
+
+    // Fail on overflow
+    if (i > (INT_MAX - d) / 10)
+      return false;
+    i = i * 10 + d;
+  }
+  value = negative ? -i : i;
+  s = p;
+  return true;
+}
+
+// Parses a float with strtof. Slow, but handles everything the fast
+// path in parseFloat() cannot (too many digits, huge exponents, etc.)
+inline bool
+parseFloatSlow(const char*& s, const char* end, float& value)
+{
+  // The mapped file is not null terminated
+  const int bufferSize{64};
+  char buffer[bufferSize];
+  auto n = int(skipToken(s, end) - s);
+
+  if (n == 0 || n >= bufferSize)
+    return false;
+  memcpy(buffer, s, n);
+  buffer[n] = '\0';
+
+  char* last;
+
+  value = strtof(buffer, &last);
+  if (last == buffer)
+    return false;
+  s += last - buffer;
+  return true;
+}
+
+// Parses a float in decimal notation, optionally followed by an exponent.
+// When the decimal mantissa has at most 53 bits and the decimal exponent
+// is small, the value is correctly rounded to double by a single
+// multiplication or division by an exact power of ten (Clinger's fast
+// path). Rounding that double to float gives the correctly rounded float
+// too, unless the double falls exactly halfway between two floats (then
+// the decimal value may be on either side of the midpoint). This covers
+// virtually every number found in mesh files; anything else, midpoints
+// included, goes to parseFloatSlow().
+inline bool
+parseFloat(const char*& s, const char* end, float& value)
+{
+  static const double powersOf10[]
+  {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  auto p = s;
+  auto negative = false;
+
+  if (p < end && (*p == '-' || *p == '+'))
+    negative = *p++ == '-';
+
+  uint64_t mantissa{0};
+  int digits{0};
+  int exponent{0};
+  auto hasDigits = false;
+
+  for (; p < end && isDigit(*p); ++p, hasDigits = true)
+    if (digits < 19)
+    {
+      mantissa = mantissa * 10 + (*p - '0');
+      digits += mantissa != 0;
+    }
+    else
+      return parseFloatSlow(s, end, value);
+  if (p < end && *p == '.')
+  {
+    for (++p; p < end && isDigit(*p); ++p, hasDigits = true)
+      if (digits < 19)
       {
-        int v;
-        int n;
-        int t;
+        mantissa = mantissa * 10 + (*p - '0');
+        digits += mantissa != 0;
+        --exponent;
+      }
+      else
+        return parseFloatSlow(s, end, value);
+  }
+  if (!hasDigits)
+    return parseFloatSlow(s, end, value);
+  if (p < end && (*p == 'e' || *p == 'E'))
+  {
+    int e;
 
-        fscanf_s(file, "%s", line, lineSize);
-        /* can be one of %d, %d//%d, %d/%d, %d/%d/%d %d//%d */
-        if (strstr(line, "//"))
-        {
-          /* v//n */
-          sscanf_s(line, "%d//%d", &v, &n);
-          fscanf_s(file, "%d//%d", &v, &n);
-          fscanf_s(file, "%d//%d", &v, &n);
-          nt++;
-          while (fscanf_s(file, "%d//%d", &v, &n) > 0)
-            nt++;
-        }
-        else if (sscanf_s(line, "%d/%d/%d", &v, &t, &n) == 3)
-        {
-          /* v/t/n */
-          fscanf_s(file, "%d/%d/%d", &v, &t, &n);
-          fscanf_s(file, "%d/%d/%d", &v, &t, &n);
-          nt++;
-          while (fscanf_s(file, "%d/%d/%d", &v, &t, &n) > 0)
-            nt++;
-        }
-        else if (sscanf_s(line, "%d/%d", &v, &t) == 2)
-        {
-          /* v/t */
-          fscanf_s(file, "%d/%d", &v, &t);
-          fscanf_s(file, "%d/%d", &v, &t);
-          nt++;
-          while (fscanf_s(file, "%d/%d", &v, &t) > 0)
-            nt++;
-        }
-        else
-        {
-          /* v */
-          fscanf_s(file, "%d", &v);
-          fscanf_s(file, "%d", &v);
-          nt++;
-          while (fscanf_s(file, "%d", &v) > 0)
-            nt++;
-        }
-        break;
+    ++p;
+    if (!parseInt(p, end, e))
+      return false;
+    if (e > 1000 || e < -1000)
+      return parseFloatSlow(s, end, value);
+    exponent += e;
+  }
+  if (mantissa > (uint64_t(1) << 53) || exponent < -22 || exponent > 22)
+    return parseFloatSlow(s, end, value);
+
+  auto d = double(mantissa);
+
+  d = exponent < 0 ? d / powersOf10[-exponent] : d * powersOf10[exponent];
+
+  // The fast path values are within the normal float range, where a
+  // double is a float midpoint if its 29 extra significand bits are 1
+  // followed by zeros
+  uint64_t bits;
+
+  memcpy(&bits, &d, sizeof bits);
+  if ((bits & 0x1fffffff) == 0x10000000)
+    return parseFloatSlow(s, end, value);
+  value = float(negative ? -d : d);
+  s = p;
+  return true;
+}
+
+/// Converts an OBJ index (1-based or negative relative) into 0-based.
+inline int
+objIndex(int i, int n)
+{
+  return i > 0 ? i - 1 : n + i;
+}
+
+using Triangle = TriangleMesh::Triangle;
+
+// OBJ face attributes
+enum
+{
+  Position,
+  UV,
+  Normal
+};
+
+struct OBJData
+{
+  Buffer<vec3f> vertices;
+  Buffer<vec2f> uv;
+  Buffer<vec3f> normals;
+  // Position, uv and normal indices of each triangle. The uv (normal)
+  // triangles are empty until a face with texture (normal) indices is
+  // read; from there on, the corners without them are set to -1
+  Buffer<Triangle> triangles[3];
+  // Positions (3 * triangle + corner) of the indices given relative to
+  // the current position, uv or normal. Those are resolved against the
+  // elements read by this object only and must be offset by the number
+  // of elements read before it when chunks are stitched together
+  Buffer<int> relativeIndices[3];
+  // First triangle and number of vertices of each face with more than
+  // three vertices. Those are fan triangulated while parsed and may be
+  // triangulated again after all positions are known
+  Buffer<int> polygons;
+  // Number of positions, uv, normals and triangles read, but already
+  // handed over to a sink (only when streaming)
+  int flushed[4]{};
+
+  int numberOfTriangles() const
+  {
+    return triangles[Position].size();
+  }
+
+  int count(int a) const
+  {
+    auto n = a == Position ? vertices.size() :
+      a == UV ? uv.size() : normals.size();
+    return flushed[a] + n;
+  }
+
+  bool hasAttribute(int a) const
+  {
+    return triangles[a].size() > 0;
+  }
+
+  // Pads the uv (normal) triangles with -1 up to triangle t
+  void padAttribute(int a, int t)
+  {
+    auto& b = triangles[a];
+
+    while (b.size() < t)
+      b.add().setVertices(-1, -1, -1);
+  }
+
+  void addTriangle(const int i[3][3])
+  {
+    auto t = numberOfTriangles();
+
+    triangles[Position].add().setVertices(i[0][0], i[0][1], i[0][2]);
+    for (int a = UV; a <= Normal; ++a)
+      if (hasAttribute(a) || i[a][0] >= 0 || i[a][1] >= 0 || i[a][2] >= 0)
+      {
+        padAttribute(a, t);
+        triangles[a].add().setVertices(i[a][0], i[a][1], i[a][2]);
+      }
+  }
+
+}; // OBJData
+
+// Parses the face whose vertex references ("v", "v/t", "v//n" or
+// "v/t/n") start at s and fan triangulates it.
+inline const char*
+readOBJFace(const char* s, const char* end, OBJData& data)
+{
+  const int count[3]
+  {
+    data.count(Position),
+    data.count(UV),
+    data.count(Normal)
+  };
+  int index[3][3]; // [attribute][corner]
+  int n{0};
+  int relative{0}; // bit 3 * attribute + corner
+  const auto first = data.numberOfTriangles();
+
+  for (;;)
+  {
+    s = skipBlanks(s, end);
+
+    // OBJ indices are never 0, so 0 stands for a missing index
+    int i[3]{};
+
+    if (!parseInt(s, end, i[Position]))
+      break;
+    if (s < end && *s == '/')
+    {
+      parseInt(++s, end, i[UV]);
+      if (s < end && *s == '/')
+        parseInt(++s, end, i[Normal]);
+    }
+    s = skipToken(s, end);
+
+    auto corner = n < 2 ? n : 2;
+
+    for (int a = Position; a <= Normal; ++a)
+    {
+      index[a][corner] = i[a] == 0 ? -1 : objIndex(i[a], count[a]);
+      if (i[a] < 0)
+        relative |= 1 << (3 * a + corner);
+    }
+    if (++n >= 3)
+    {
+      auto t = data.numberOfTriangles();
+
+      data.addTriangle(index);
+      for (int k = 0; relative != 0 && k < 9; ++k)
+        if (relative & (1 << k))
+          data.relativeIndices[k / 3].add() = 3 * t + k % 3;
+      for (int a = Position; a <= Normal; ++a)
+        index[a][1] = index[a][2];
+      // Corner 0 stays, corner 2 becomes corner 1
+      relative = (relative & 0x49) | ((relative & 0x124) >> 1);
+    }
+  }
+  if (n > 3)
+  {
+    data.polygons.add() = first;
+    data.polygons.add() = n;
+  }
+  return s;
+}
+
+inline const char*
+readOBJFloats(const char* s, const char* end, float* f, int n)
+{
+  for (int i = 0; i < n; ++i)
+  {
+    s = skipBlanks(s, end);
+    if (!parseFloat(s, end, f[i]))
+      f[i] = 0;
+  }
+  return s;
+}
+
+// Reads, in a single pass, the vertices, texture coordinates, normals
+// and faces of the OBJ text in [s, end). flush(data) is invoked after
+// each line.
+template <typename Flush>
+void
+readOBJData(const char* s, const char* end, OBJData& data, const Flush& flush)
+{
+  while (s < end)
+  {
+    s = skipBlanks(s, end);
+    if (s + 1 < end)
+      switch (*s)
+      {
+        case 'v':
+          if (isBlank(s[1]))
+          {
+            auto& p = data.vertices.add();
+            s = readOBJFloats(s + 2, end, &p.x, 3);
+          }
+          else if (s + 2 < end && isBlank(s[2]))
+          {
+            if (s[1] == 't')
+            {
+              auto& t = data.uv.add();
+              s = readOBJFloats(s + 3, end, &t.x, 2);
+            }
+            else if (s[1] == 'n')
+            {
+              auto& n = data.normals.add();
+              s = readOBJFloats(s + 3, end, &n.x, 3);
+            }
+          }
+          break;
+
+        case 'f':
+          if (isBlank(s[1]))
+            s = readOBJFace(s + 2, end, data);
+          break;
+      }
+    s = skipLine(s, end);
+    flush(data);
+  }
+  for (int a = UV; a <= Normal; ++a)
+    if (data.hasAttribute(a))
+      data.padAttribute(a, data.numberOfTriangles());
+}
+
+inline void
+readOBJData(const char* s, const char* end, OBJData& data)
+{
+  readOBJData(s, end, data, [](OBJData&) {});
+}
+
+// Hands the buffered elements of data over to sink, in batches of
+// batchSize elements at most, and empties the buffers. If all is
+// false, only buffers holding at least batchSize elements are flushed.
+void
+flushOBJData(OBJData& data,
+  MeshReader::Sink& sink,
+  int batchSize,
+  bool all = false)
+{
+  const auto min = all ? 1 : batchSize;
+  auto flush = [&](auto& buffer, int a, const auto& deliver)
+  {
+    auto n = a == 3 ? data.numberOfTriangles() : buffer.size();
+
+    if (n < min)
+      return;
+    for (int i = 0; i < n; i += batchSize)
+      deliver(i, data.flushed[a] + i, std::min(batchSize, n - i));
+    data.flushed[a] += n;
+    buffer.clear();
+  };
+
+  flush(data.vertices, Position, [&](int i, int first, int n)
+  {
+    sink.positions(data.vertices.data() + i, first, n);
+  });
+  flush(data.uv, UV, [&](int i, int first, int n)
+  {
+    sink.uv(data.uv.data() + i, first, n);
+  });
+  flush(data.normals, Normal, [&](int i, int first, int n)
+  {
+    sink.normals(data.normals.data() + i, first, n);
+  });
+
+  // Indices are resolved against the global counts while streaming,
+  // and polygons are delivered fan triangulated
+  for (auto& r : data.relativeIndices)
+    r.clear();
+  data.polygons.clear();
+  if (data.numberOfTriangles() < min)
+    return;
+
+  const Triangle* t[3]{};
+
+  for (int a = Position; a <= Normal; ++a)
+    if (data.hasAttribute(a))
+    {
+      data.padAttribute(a, data.numberOfTriangles());
+      t[a] = data.triangles[a].data();
+    }
+  flush(data.triangles[Position], 3, [&](int i, int first, int n)
+  {
+    sink.triangles(t[Position] + i,
+      t[UV] ? t[UV] + i : nullptr,
+      t[Normal] ? t[Normal] + i : nullptr,
+      first,
+      n);
+  });
+  data.triangles[UV].clear();
+  data.triangles[Normal].clear();
+}
+
+//
+// Triangulator of the polygonal faces of an OBJ file
+//
+class OBJPolygonTriangulator
+{
+public:
+  // Triangulates again, if not convex, the polygons of chunk, whose
+  // fan triangles start at triangle base of data. The number of
+  // triangles of a polygon does not change.
+  void triangulate(OBJData& data, const OBJData& chunk, int base, int i)
+  {
+    auto first = base + chunk.polygons.data()[2 * i];
+    auto n = chunk.polygons.data()[2 * i + 1];
+
+    // Recover the polygon corners from its fan
+    auto fan = data.triangles[Position].data() + first;
+
+    _corners.resize(n);
+    _corners[0] = fan[0].v[0];
+    _corners[1] = fan[0].v[1];
+    for (int k = 2; k < n; ++k)
+      _corners[k] = fan[k - 2].v[2];
+    if (!project(data) || isConvex())
+      return;
+    earClip();
+    for (int a = Position; a <= Normal; ++a)
+    {
+      if (!data.hasAttribute(a))
+        continue;
+
+      auto t = data.triangles[a].data() + first;
+
+      _attribute.resize(n);
+      _attribute[0] = t[0].v[0];
+      _attribute[1] = t[0].v[1];
+      for (int k = 2; k < n; ++k)
+        _attribute[k] = t[k - 2].v[2];
+      for (int k = 0; k < n - 2; ++k)
+        t[k].setVertices(_attribute[_triangles[3 * k]],
+          _attribute[_triangles[3 * k + 1]],
+          _attribute[_triangles[3 * k + 2]]);
+    }
+  }
+
+private:
+  std::vector<int> _corners;
+  std::vector<int> _attribute;
+  std::vector<vec2f> _points;
+  std::vector<int> _prev;
+  std::vector<int> _next;
+  std::vector<int> _triangles;
+
+  static float cross(const vec2f& a, const vec2f& b, const vec2f& c)
+  {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+  }
+
+  // Projects the polygon onto the coordinate plane most parallel to it,
+  // counterclockwise. Returns false if the polygon has invalid indices.
+  bool project(const OBJData& data)
+  {
+    const auto n = int(_corners.size());
+    const auto nv = data.vertices.size();
+    auto v = data.vertices.data();
+    vec3f normal{0.0f};
+
+    for (int i = 0; i < n; ++i)
+    {
+      auto c = _corners[i];
+      auto d = _corners[(i + 1) % n];
+
+      if (c < 0 || c >= nv || d < 0 || d >= nv)
+        return false;
+      // Newell's method
+      normal.x += (v[c].y - v[d].y) * (v[c].z + v[d].z);
+      normal.y += (v[c].z - v[d].z) * (v[c].x + v[d].x);
+      normal.z += (v[c].x - v[d].x) * (v[c].y + v[d].y);
+    }
+
+    const vec3f a{math::abs(normal.x), math::abs(normal.y), math::abs(normal.z)};
+    int k = a.x > a.y ? (a.x > a.z ? 0 : 2) : (a.y > a.z ? 1 : 2);
+    int x = (k + 1) % 3;
+    int y = (k + 2) % 3;
+
+    if (normal[k] < 0)
+      std::swap(x, y);
+    _points.resize(n);
+    for (int i = 0; i < n; ++i)
+      _points[i].set(v[_corners[i]][x], v[_corners[i]][y]);
+    return true;
+  }
+
+  bool isConvex() const
+  {
+    const auto n = int(_points.size());
+
+    for (int i = 0; i < n; ++i)
+      if (cross(_points[i], _points[(i + 1) % n], _points[(i + 2) % n]) < 0)
+        return false;
+    return true;
+  }
+
+  bool isEar(int i) const
+  {
+    const auto& a = _points[_prev[i]];
+    const auto& b = _points[i];
+    const auto& c = _points[_next[i]];
+
+    if (cross(a, b, c) <= 0)
+      return false;
+    for (int j = _next[_next[i]]; j != _prev[i]; j = _next[j])
+    {
+      const auto& p = _points[j];
+
+      // Points coincident with a corner do not block the ear
+      if (p == a || p == b || p == c)
+        continue;
+      if (cross(a, b, p) >= 0 && cross(b, c, p) >= 0 && cross(c, a, p) >= 0)
+        return false;
+    }
+    return true;
+  }
+
+  // Triangulates the projected polygon by ear clipping
+  void earClip()
+  {
+    const auto n = int(_points.size());
+
+    _prev.resize(n);
+    _next.resize(n);
+    for (int i = 0; i < n; ++i)
+    {
+      _prev[i] = (i + n - 1) % n;
+      _next[i] = (i + 1) % n;
+    }
+    _triangles.clear();
+
+    int i{0};
+
+    for (auto m = n; m > 3; --m)
+    {
+      auto j = i;
+
+      while (!isEar(j))
+        // If there is no ear (e.g., self-intersecting polygons), clip
+        // any corner, so that we still get n - 2 triangles
+        if ((j = _next[j]) == i)
+          break;
+      _triangles.insert(_triangles.end(), {_prev[j], j, _next[j]});
+      _next[_prev[j]] = _next[j];
+      _prev[_next[j]] = _prev[j];
+      i = _next[j];
+    }
+    _triangles.insert(_triangles.end(), {_prev[i], i, _next[i]});
+  }
+
+}; // OBJPolygonTriangulator
+
+// Triangulates the non-convex polygons of chunk, whose triangles start
+// at triangle base of data. See OBJPolygonTriangulator.
+void
+triangulateOBJPolygons(OBJData& data,
+  const OBJData& chunk,
+  int base,
+  int numberOfThreads)
+{
+  parallel::forRange(chunk.polygons.size() / 2, 1024, [&](int b, int e)
+  {
+    OBJPolygonTriangulator triangulator;
+
+    for (int i = b; i < e; ++i)
+      triangulator.triangulate(data, chunk, base, i);
+  }, numberOfThreads);
+}
+
+//
+// Reporter of the progress of a read to a progress callback
+//
+class ReadMonitor
+{
+public:
+  ReadMonitor(const MeshReader::ProgressCallback& callback, size_t fileSize):
+    _callback{callback},
+    _start{std::chrono::steady_clock::now()},
+    _cancelled{false}
+  {
+    _progress.bytesRead = 0;
+    _progress.fileSize = fileSize;
+    _progress.seconds = 0;
+  }
+
+  bool cancelled() const
+  {
+    return _cancelled;
+  }
+
+  // Adds bytes to the number of bytes read and reports the progress.
+  // Returns false if the read has been cancelled. Thread-safe.
+  bool advance(size_t bytes)
+  {
+    if (!_callback)
+      return true;
+    if (_cancelled)
+      return false;
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    std::chrono::duration<double> t{std::chrono::steady_clock::now() - _start};
+
+    _progress.bytesRead += bytes;
+    _progress.seconds = t.count();
+    if (!_callback(_progress))
+      _cancelled = true;
+    return !_cancelled;
+  }
+
+private:
+  const MeshReader::ProgressCallback& _callback;
+  std::chrono::steady_clock::time_point _start;
+  MeshReader::Progress _progress;
+  std::atomic<bool> _cancelled;
+  std::mutex _mutex;
+
+}; // ReadMonitor
+
+// Number of bytes parsed between two progress reports
+const size_t sliceSize{1024 * 1024};
+
+// Parses the OBJ text in [s, end) into data, in slices of about
+// sliceSize bytes, reporting to monitor after each slice. Returns
+// false if the read is cancelled.
+bool
+readOBJSlices(const char* s,
+  const char* end,
+  OBJData& data,
+  ReadMonitor& monitor)
+{
+  while (s < end)
+  {
+    auto e = size_t(end - s) > sliceSize ? skipLine(s + sliceSize, end) : end;
+
+    readOBJData(s, e, data);
+    if (!monitor.advance(size_t(e - s)))
+      return false;
+    s = e;
+  }
+  return true;
+}
+
+// Minimum number of bytes of a chunk parsed by a thread
+const size_t minChunkSize{512 * 1024};
+
+// Splits [s, end) into at most numberOfThreads chunks at line
+// boundaries, parses each one on its own thread and concatenates
+// the results, in file order, into data. Returns false if the read
+// is cancelled.
+bool
+readOBJDataParallel(const char* s,
+  const char* end,
+  OBJData& data,
+  int numberOfThreads,
+  ReadMonitor& monitor)
+{
+  const auto size = size_t(end - s);
+  auto n = std::min(size_t(numberOfThreads), size / minChunkSize);
+  std::vector<const char*> bounds(n + 1);
+
+  bounds[0] = s;
+  bounds[n] = end;
+  for (size_t i = 1; i < n; ++i)
+    bounds[i] = skipLine(std::max(s + size * i / n, bounds[i - 1]), end);
+
+  std::vector<OBJData> chunks(n);
+
+  parallel::run(int(n), [&](int i)
+  {
+    auto& chunk = chunks[i];
+    auto chunkSize = size_t(bounds[i + 1] - bounds[i]);
+
+    chunk.vertices.reserve(int(chunkSize / 96));
+    chunk.triangles[Position].reserve(int(chunkSize / 48));
+    readOBJSlices(bounds[i], bounds[i + 1], chunk, monitor);
+  });
+  if (monitor.cancelled())
+    return false;
+
+  // Prefix sums of the element counts of the chunks
+  std::vector<int> base[4]; // positions, uv, normals, triangles
+  bool hasAttribute[3]{true};
+
+  for (auto& b : base)
+    b.resize(n + 1);
+  for (size_t i = 0; i < n; ++i)
+  {
+    auto& chunk = chunks[i];
+
+    base[Position][i + 1] = base[Position][i] + chunk.vertices.size();
+    base[UV][i + 1] = base[UV][i] + chunk.uv.size();
+    base[Normal][i + 1] = base[Normal][i] + chunk.normals.size();
+    base[3][i + 1] = base[3][i] + chunk.numberOfTriangles();
+    hasAttribute[UV] |= chunk.hasAttribute(UV);
+    hasAttribute[Normal] |= chunk.hasAttribute(Normal);
+  }
+  data.vertices.resize(base[Position][n]);
+  data.uv.resize(base[UV][n]);
+  data.normals.resize(base[Normal][n]);
+  for (int a = Position; a <= Normal; ++a)
+    if (hasAttribute[a])
+      data.triangles[a].resize(base[3][n]);
+
+  auto copy = [](auto& dst, const auto& src, int offset)
+  {
+    if (auto n = src.size())
+      memcpy(dst.data() + offset, src.data(), n * sizeof(*src.data()));
+  };
+
+  parallel::run(int(n), [&](int i)
+  {
+    auto& chunk = chunks[i];
+
+    copy(data.vertices, chunk.vertices, base[Position][i]);
+    copy(data.uv, chunk.uv, base[UV][i]);
+    copy(data.normals, chunk.normals, base[Normal][i]);
+    for (int a = Position; a <= Normal; ++a)
+    {
+      if (!hasAttribute[a])
+        continue;
+
+      auto t = data.triangles[a].data() + base[3][i];
+
+      if (chunk.hasAttribute(a))
+        copy(data.triangles[a], chunk.triangles[a], base[3][i]);
+      else
+        for (int k = 0; k < chunk.numberOfTriangles(); ++k)
+          t[k].setVertices(-1, -1, -1);
+
+      auto& r = chunk.relativeIndices[a];
+
+      for (int k = 0; k < r.size(); ++k)
+        t[r[k] / 3].v[r[k] % 3] += base[a][i];
+    }
+  });
+  // Polygons can refer to positions of other chunks
+  parallel::run(int(n), [&](int i)
+  {
+    triangulateOBJPolygons(data, chunks[i], base[3][i], 1);
+  });
+  return true;
+}
+
+inline uint32_t
+hashTriple(const int k[3])
+{
+  auto h = uint32_t(k[0]) * 0x9e3779b1u;
+
+  h ^= uint32_t(k[1]) * 0x85ebca77u + (h >> 15);
+  h ^= uint32_t(k[2]) * 0xc2b2ae3du + (h >> 13);
+  return h ^ (h >> 16);
+}
+
+// Makes one mesh vertex of each distinct (position, uv, normal) index
+// triple referenced by the faces, with an open addressing hash table.
+// Mesh vertices whose triple has no normal get the average of the
+// normals of their faces. The position indices must be valid (see
+// removeInvalidOBJTriangles()); invalid uv and normal indices are
+// taken as missing.
+void
+weldOBJVertices(OBJData& obj, TriangleMesh::Data& data)
+{
+  const auto nt = obj.numberOfTriangles();
+  const auto hasUV = obj.hasAttribute(UV) && obj.uv.size() > 0;
+  const auto hasNormals = obj.hasAttribute(Normal) && obj.normals.size() > 0;
+  const int count[3]{obj.vertices.size(), obj.uv.size(), obj.normals.size()};
+  uint32_t capacity{1024};
+
+  while (capacity < uint32_t(6 * nt))
+    capacity *= 2;
+
+  const auto mask = capacity - 1;
+  std::vector<int> table(capacity, -1);
+  std::vector<int> keys; // 3 indices of each mesh vertex
+  auto triangles = new Triangle[nt];
+
+  keys.reserve(3 * size_t(nt));
+  for (int t = 0; t < nt; ++t)
+    for (int c = 0; c < 3; ++c)
+    {
+      int k[3];
+
+      for (int a = Position; a <= Normal; ++a)
+      {
+        auto i = obj.hasAttribute(a) ? obj.triangles[a][t].v[c] : -1;
+        k[a] = i >= 0 && i < count[a] ? i : -1;
       }
 
-      default:
-        fgets(line, lineSize, file);
+      auto h = hashTriple(k) & mask;
+      int v;
+
+      while ((v = table[h]) >= 0)
+      {
+        auto kv = &keys[3 * v];
+
+        if (kv[0] == k[0] && kv[1] == k[1] && kv[2] == k[2])
+          break;
+        h = (h + 1) & mask;
+      }
+      if (v < 0)
+      {
+        table[h] = v = int(keys.size() / 3);
+        keys.insert(keys.end(), k, k + 3);
+      }
+      triangles[t].v[c] = v;
     }
+
+  const auto nv = int(keys.size() / 3);
+
   data.numberOfVertices = nv;
+  data.vertices = new vec3f[nv];
+  data.vertexNormals = hasNormals ? new vec3f[nv] : nullptr;
+  data.uv = hasUV ? new vec2f[nv] : nullptr;
   data.numberOfTriangles = nt;
+  data.triangles = triangles;
+
+  auto missingNormals = false;
+
+  for (int v = 0; v < nv; ++v)
+  {
+    auto k = &keys[3 * v];
+
+    data.vertices[v] = obj.vertices[k[Position]];
+    if (hasUV)
+      data.uv[v] = k[UV] < 0 ? vec2f{0, 0} : obj.uv[k[UV]];
+    if (!hasNormals)
+      continue;
+    if (k[Normal] >= 0)
+      data.vertexNormals[v] = obj.normals[k[Normal]];
+    else
+    {
+      data.vertexNormals[v] = vec3f::null();
+      missingNormals = true;
+    }
+  }
+  if (!missingNormals)
+    return;
+  // Some faces have no normal indices
+  for (int t = 0; t < nt; ++t)
+  {
+    auto v = triangles[t].v;
+    auto normal = triangle::normal(data.vertices, v);
+
+    for (int c = 0; c < 3; ++c)
+      if (keys[3 * v[c] + Normal] < 0)
+        data.vertexNormals[v[c]] += normal;
+  }
+  for (int v = 0; v < nv; ++v)
+    if (keys[3 * v + Normal] < 0)
+      data.vertexNormals[v].normalize();
 }
 
+// Removes the triangles with a position index out of the vertices
+// read, along with their uv and normal indices.
 void
-readMeshData(FILE* file, TriangleMesh::Data& data)
+removeInvalidOBJTriangles(OBJData& obj)
+{
+  const auto nv = unsigned(obj.vertices.size());
+  const auto nt = obj.numberOfTriangles();
+  int n{0};
+
+  for (int t = 0; t < nt; ++t)
+  {
+    const auto v = obj.triangles[Position][t].v;
+
+    if (unsigned(v[0]) >= nv || unsigned(v[1]) >= nv || unsigned(v[2]) >= nv)
+      continue;
+    if (n < t)
+      for (auto& triangles : obj.triangles)
+        if (triangles.size() > 0)
+          triangles[n] = triangles[t];
+    ++n;
+  }
+  if (n < nt)
+    for (auto& triangles : obj.triangles)
+      if (triangles.size() > 0)
+        triangles.resize(n);
+}
+
+// Moves the data read from an OBJ file into a mesh data. If the faces
+// have no texture or normal indices, the OBJ vertices become the mesh
+// vertices as they are; otherwise they are welded. Returns false if
+// the file has faces but no vertices.
+bool
+makeMeshData(OBJData& obj, TriangleMesh::Data& data)
+{
+  if (obj.numberOfTriangles() > 0 && obj.vertices.size() == 0)
+    return false;
+  removeInvalidOBJTriangles(obj);
+  if (obj.hasAttribute(UV) || obj.hasAttribute(Normal))
+  {
+    weldOBJVertices(obj, data);
+    return true;
+  }
+  data.numberOfVertices = obj.vertices.size();
+  data.vertices = obj.vertices.release();
+  data.vertexNormals = nullptr;
+  data.numberOfTriangles = obj.numberOfTriangles();
+  data.triangles = obj.triangles[Position].release();
+  return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// PLY and STL reading
+//
+inline bool
+isHostLittleEndian()
+{
+  const uint16_t one{1};
+  return *(const unsigned char*)&one == 1;
+}
+
+// Loads a value of type T, stored with swapped bytes if swap is true,
+// from a possibly unaligned address
+template <typename T>
+inline T
+loadValue(const char* p, bool swap)
+{
+  T value;
+
+  if (!swap)
+    memcpy(&value, p, sizeof(T));
+  else
+  {
+    char b[sizeof(T)];
+
+    for (size_t i = 0; i < sizeof(T); ++i)
+      b[i] = p[sizeof(T) - 1 - i];
+    memcpy(&value, b, sizeof(T));
+  }
+  return value;
+}
+
+inline std::string_view
+nextToken(const char*& s, const char* end)
+{
+  s = skipBlanks(s, end);
+
+  auto t = s;
+
+  s = skipToken(s, end);
+  return std::string_view{t, size_t(s - t)};
+}
+
+enum class PLYType
+{
+  Int8,
+  UInt8,
+  Int16,
+  UInt16,
+  Int32,
+  UInt32,
+  Float32,
+  Float64,
+  Invalid
+};
+
+inline PLYType
+plyType(std::string_view name)
 {
-  const unsigned int lineSize{128};
-  auto vertex = data.vertices;
-  auto triangle = data.triangles;
+  static const struct
+  {
+    const char* name;
+    PLYType type;
+  } types[]
+  {
+    {"char", PLYType::Int8}, {"int8", PLYType::Int8},
+    {"uchar", PLYType::UInt8}, {"uint8", PLYType::UInt8},
+    {"short", PLYType::Int16}, {"int16", PLYType::Int16},
+    {"ushort", PLYType::UInt16}, {"uint16", PLYType::UInt16},
+    {"int", PLYType::Int32}, {"int32", PLYType::Int32},
+    {"uint", PLYType::UInt32}, {"uint32", PLYType::UInt32},
+    {"float", PLYType::Float32}, {"float32", PLYType::Float32},
+    {"double", PLYType::Float64}, {"float64", PLYType::Float64}
+  };
 
-  for (char line[lineSize]; fscanf_s(file, "%s", line, lineSize) != EOF;)
-    switch (line[0])
+  for (const auto& t : types)
+    if (name == t.name)
+      return t.type;
+  return PLYType::Invalid;
+}
+
+inline int
+plySize(PLYType type)
+{
+  static const int sizes[]{1, 1, 2, 2, 4, 4, 4, 8, 0};
+  return sizes[int(type)];
+}
+
+inline double
+plyValue(const char* p, PLYType type, bool swap)
+{
+  switch (type)
+  {
+    case PLYType::Int8: return *(const int8_t*)p;
+    case PLYType::UInt8: return *(const uint8_t*)p;
+    case PLYType::Int16: return loadValue<int16_t>(p, swap);
+    case PLYType::UInt16: return loadValue<uint16_t>(p, swap);
+    case PLYType::Int32: return loadValue<int32_t>(p, swap);
+    case PLYType::UInt32: return loadValue<uint32_t>(p, swap);
+    case PLYType::Float32: return loadValue<float>(p, swap);
+    case PLYType::Float64: return loadValue<double>(p, swap);
+    default: return 0;
+  }
+}
+
+struct PLYProperty
+{
+  std::string name;
+  PLYType type;
+  PLYType countType; // Invalid if not a list
+  int offset; // in a fixed size element
+
+}; // PLYProperty
+
+struct PLYElement
+{
+  std::string name;
+  int count;
+  std::vector<PLYProperty> properties;
+  int size; // bytes of each element, or 0 if it has lists
+
+  int find(const char* name) const
+  {
+    for (int i = 0, n = int(properties.size()); i < n; ++i)
+      if (properties[i].name == name)
+        return i;
+    return -1;
+  }
+
+}; // PLYElement
+
+enum class PLYFormat
+{
+  ASCII,
+  BinaryLittleEndian,
+  BinaryBigEndian
+};
+
+// Reads the header of a PLY file. On return, s points to the data.
+bool
+readPLYHeader(const char*& s,
+  const char* end,
+  PLYFormat& format,
+  std::vector<PLYElement>& elements)
+{
+  if (nextToken(s, end) != "ply")
+    return false;
+
+  auto hasFormat = false;
+
+  for (s = skipLine(s, end); s < end; s = skipLine(s, end))
+  {
+    auto keyword = nextToken(s, end);
+
+    if (keyword == "format")
     {
-      case 'v':
+      auto f = nextToken(s, end);
+
+      if (f == "ascii")
+        format = PLYFormat::ASCII;
+      else if (f == "binary_little_endian")
+        format = PLYFormat::BinaryLittleEndian;
+      else if (f == "binary_big_endian")
+        format = PLYFormat::BinaryBigEndian;
+      else
+        return false;
+      hasFormat = true;
+    }
+    else if (keyword == "element")
+    {
+      auto& e = elements.emplace_back();
+
+      e.name = nextToken(s, end);
+      if (!parseInt(s = skipBlanks(s, end), end, e.count) || e.count < 0)
+        return false;
+      e.size = 0;
+    }
+    else if (keyword == "property")
+    {
+      if (elements.empty())
+        return false;
+
+      auto& e = elements.back();
+      auto& p = e.properties.emplace_back();
+      auto type = nextToken(s, end);
+
+      p.countType = PLYType::Invalid;
+      if (type == "list")
       {
-        float x;
-        float y;
-        float z;
+        if ((p.countType = plyType(nextToken(s, end))) == PLYType::Invalid)
+          return false;
+        type = nextToken(s, end);
+      }
+      if ((p.type = plyType(type)) == PLYType::Invalid)
+        return false;
+      p.name = nextToken(s, end);
+      p.offset = e.size;
+      // Elements with list properties have no fixed size
+      if (p.countType != PLYType::Invalid || (e.size < 0))
+        e.size = -1;
+      else
+        e.size += plySize(p.type);
+    }
+    else if (keyword == "end_header")
+    {
+      s = skipLine(s, end);
+      for (auto& e : elements)
+        if (e.size < 0)
+          e.size = 0;
+      return hasFormat;
+    }
+  }
+  return false;
+}
 
-        switch (line[1])
-        {
-          case '\0':
-            fscanf_s(file, "%f %f %f", &x, &y, &z);
-            vertex->set(x, y, z);
-            vertex++;
-            break;
-
-          default:
-            fgets(line, lineSize, file);
-        }
-        break;
+//
+// Reader of the elements of a PLY file, in ASCII or binary format
+//
+class PLYElementReader
+{
+public:
+  PLYElementReader(PLYFormat format,
+    const char* begin,
+    const char* s,
+    const char* end):
+    _s{s},
+    _end{end},
+    _reported{begin},
+    _ascii{format == PLYFormat::ASCII},
+    _swap{(format == PLYFormat::BinaryLittleEndian) != isHostLittleEndian()}
+  {
+    // do nothing
+  }
+
+  bool ascii() const
+  {
+    return _ascii;
+  }
+
+  bool swap() const
+  {
+    return _swap;
+  }
+
+  const char* position() const
+  {
+    return _s;
+  }
+
+  void skip(size_t bytes)
+  {
+    _s += bytes;
+  }
+
+  // Reports the bytes read since the last report to monitor. Returns
+  // false if the read has been cancelled.
+  bool report(ReadMonitor& monitor)
+  {
+    auto bytes = size_t(_s - _reported);
+
+    _reported = _s;
+    return monitor.advance(bytes);
+  }
+
+  size_t remaining() const
+  {
+    return size_t(_end - _s);
+  }
+
+  // Returns true if the rest of the data is large enough to hold the
+  // count elements declared by e: in ASCII, every value takes at least
+  // one character and a separator; in binary, the size of its type (or
+  // of its count, if it is a list). Lets a huge count be rejected before
+  // anything is allocated for it.
+  bool canHold(const PLYElement& e) const
+  {
+    size_t size{0};
+
+    for (const auto& p : e.properties)
+      if (_ascii)
+        size += 2;
+      else
+        size += plySize(p.countType != PLYType::Invalid ? p.countType : p.type);
+    return size == 0 || (remaining() + 1) / size >= size_t(e.count);
+  }
+
+  // Reads the next value of type t. Returns false at the end of data.
+  bool read(PLYType t, double& value)
+  {
+    if (_ascii)
+    {
+      // Values of an element may span several lines
+      while (_s < _end && (isBlank(*_s) || *_s == '\n'))
+        ++_s;
+
+      float f;
+
+      if (t >= PLYType::Float32)
+      {
+        if (!parseFloat(_s, _end, f))
+          return false;
+        value = f;
+      }
+      else
+      {
+        int i;
+
+        if (!parseInt(_s, _end, i))
+          return false;
+        value = i;
       }
+      return true;
+    }
+
+    auto size = size_t(plySize(t));
+
+    if (remaining() < size)
+      return false;
+    value = plyValue(_s, t, _swap);
+    _s += size;
+    return true;
+  }
 
-      case 'f':
+  // Skips the element whose properties are given
+  bool skip(const PLYElement& e)
+  {
+    if (!_ascii && e.size > 0)
+    {
+      if (remaining() < size_t(e.size))
+        return false;
+      _s += e.size;
+      return true;
+    }
+    for (const auto& p : e.properties)
+    {
+      double count{1};
+
+      if (p.countType != PLYType::Invalid && !read(p.countType, count))
+        return false;
+      for (auto n = int(count); n > 0; --n)
       {
-        int v;
-        int n;
-        int t;
+        double value;
 
-        fscanf_s(file, "%s", line, lineSize);
-        /* Can be one of %d, %d//%d, %d/%d, %d/%d/%d %d//%d */
-        if (strstr(line, "//"))
-        {
-          /* v//n */
-          sscanf_s(line, "%d//%d", &v, &n);
-          triangle->v[0] = v - 1;
-          fscanf_s(file, "%d//%d", &v, &n);
-          triangle->v[1] = v - 1;
-          fscanf_s(file, "%d//%d", &v, &n);
-          triangle->v[2] = v - 1;
-          triangle++;
-          while (fscanf_s(file, "%d//%d", &v, &n) > 0)
-          {
-            triangle->v[0] = triangle[-1].v[0];
-            triangle->v[1] = triangle[-1].v[2];
-            triangle->v[2] = v - 1;
-            triangle++;
-          }
-        }
-        else if (sscanf_s(line, "%d/%d/%d", &v, &t, &n) == 3)
-        {
-          /* v/t/n */
-          triangle->v[0] = v - 1;
-          fscanf_s(file, "%d/%d/%d", &v, &t, &n);
-          triangle->v[1] = v - 1;
-          fscanf_s(file, "%d/%d/%d", &v, &t, &n);
-          triangle->v[2] = v - 1;
-          triangle++;
-          while (fscanf_s(file, "%d/%d/%d", &v, &t, &n) > 0)
-          {
-            triangle->v[0] = triangle[-1].v[0];
-            triangle->v[1] = triangle[-1].v[2];
-            triangle->v[2] = v - 1;
-            triangle++;
-          }
-        }
-        else if (sscanf_s(line, "%d/%d", &v, &t) == 2)
-        {
-          /* v/t */
-          triangle->v[0] = v - 1;
-          fscanf_s(file, "%d/%d", &v, &t);
-          triangle->v[1] = v - 1;
-          fscanf_s(file, "%d/%d", &v, &t);
-          triangle->v[2] = v - 1;
-          triangle++;
-          while (fscanf_s(file, "%d/%d", &v, &t) > 0)
-          {
-            triangle->v[0] = triangle[-1].v[0];
-            triangle->v[1] = triangle[-1].v[2];
-            triangle->v[2] = v - 1;
-            triangle++;
-          }
-        }
-        else
+        if (!read(p.type, value))
+          return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  const char* _s;
+  const char* _end;
+  const char* _reported;
+  bool _ascii;
+  bool _swap;
+
+}; // PLYElementReader
+
+// Number of elements read between two progress reports
+const int reportInterval{64 * 1024};
+
+bool
+readPLYVertices(PLYElementReader& reader,
+  const PLYElement& e,
+  OBJData& data,
+  ReadMonitor& monitor)
+{
+  const int position[3]{e.find("x"), e.find("y"), e.find("z")};
+  int normal[3]{e.find("nx"), e.find("ny"), e.find("nz")};
+  int uv[2]{e.find("u"), e.find("v")};
+
+  if (position[0] < 0 || position[1] < 0 || position[2] < 0)
+    return false;
+  if (uv[0] < 0 || uv[1] < 0)
+  {
+    uv[0] = e.find("s");
+    uv[1] = e.find("t");
+  }
+  if (uv[0] < 0 || uv[1] < 0)
+  {
+    uv[0] = e.find("texture_u");
+    uv[1] = e.find("texture_v");
+  }
+
+  const auto hasNormals = normal[0] >= 0 && normal[1] >= 0 && normal[2] >= 0;
+  const auto hasUV = uv[0] >= 0 && uv[1] >= 0;
+  const auto n = e.count;
+
+  if (!reader.canHold(e))
+    return false;
+  data.vertices.resize(n);
+  if (hasNormals)
+    data.normals.resize(n);
+  if (hasUV)
+    data.uv.resize(n);
+
+  auto v = data.vertices.data();
+
+  // Binary, fixed size vertices: copy the float components directly
+  if (!reader.ascii() && e.size > 0)
+  {
+    if (reader.remaining() < size_t(e.size) * n)
+      return false;
+
+    auto isFloat = [&](int i)
+    {
+      return e.properties[i].type == PLYType::Float32;
+    };
+    auto p = reader.position();
+
+    if (e.size == 12 && position[0] == 0 && position[1] == 1
+      && position[2] == 2 && isFloat(0) && isFloat(1) && isFloat(2)
+      && !reader.swap())
+      // Nothing but x, y and z
+      memcpy(v, p, 12 * size_t(n));
+    else
+      for (int i = 0; i < n; ++i, p += e.size)
+      {
+        auto load = [&](int k)
         {
-          /* v */
-          sscanf_s(line, "%d", &v);
-          triangle->v[0] = v - 1;
-          fscanf_s(file, "%d", &v);
-          triangle->v[1] = v - 1;
-          fscanf_s(file, "%d", &v);
-          triangle->v[2] = v - 1;
-          triangle++;
-          while (fscanf_s(file, "%d", &v) > 0)
-          {
-            triangle->v[0] = triangle[-1].v[0];
-            triangle->v[1] = triangle[-1].v[2];
-            triangle->v[2] = v - 1;
-            triangle++;
-          }
-        }
-        break;
+          const auto& q = e.properties[k];
+          return float(plyValue(p + q.offset, q.type, reader.swap()));
+        };
+
+        v[i].set(load(position[0]), load(position[1]), load(position[2]));
+        if (hasNormals)
+          data.normals[i].set(load(normal[0]), load(normal[1]),
+            load(normal[2]));
+        if (hasUV)
+          data.uv[i].set(load(uv[0]), load(uv[1]));
+      }
+    reader.skip(size_t(e.size) * n);
+    return true;
+  }
+
+  const auto np = int(e.properties.size());
+  std::vector<float> values(np);
+
+  for (int i = 0; i < n; ++i)
+  {
+    if (i % reportInterval == reportInterval - 1 && !reader.report(monitor))
+      return false;
+    for (int k = 0; k < np; ++k)
+    {
+      const auto& q = e.properties[k];
+      double value{0};
+
+      if (q.countType != PLYType::Invalid)
+      {
+        double count;
+
+        if (!reader.read(q.countType, count))
+          return false;
+        for (auto m = int(count); m > 0; --m)
+          if (!reader.read(q.type, value))
+            return false;
+      }
+      else if (!reader.read(q.type, value))
+        return false;
+      values[k] = float(value);
+    }
+    v[i].set(values[position[0]], values[position[1]], values[position[2]]);
+    if (hasNormals)
+      data.normals[i].set(values[normal[0]], values[normal[1]],
+        values[normal[2]]);
+    if (hasUV)
+      data.uv[i].set(values[uv[0]], values[uv[1]]);
+  }
+  return true;
+}
+
+bool
+readPLYFaces(PLYElementReader& reader,
+  const PLYElement& e,
+  OBJData& data,
+  ReadMonitor& monitor)
+{
+  auto indices = e.find("vertex_indices");
+
+  if (indices < 0)
+    indices = e.find("vertex_index");
+  if (indices < 0 || e.properties[indices].countType == PLYType::Invalid)
+    return reader.skip(e);
+
+  const auto nv = data.vertices.size();
+  const auto& list = e.properties[indices];
+  const auto np = int(e.properties.size());
+  // Binary, only the list of 32-bit integer indices with an 8-bit count,
+  // whose triangles are copied straight from the file
+  const auto fast = !reader.ascii()
+    && np == 1
+    && list.countType == PLYType::UInt8
+    && (list.type == PLYType::Int32 || list.type == PLYType::UInt32);
+  std::vector<int> face;
+
+  if (!reader.canHold(e))
+    return false;
+  data.triangles[Position].reserve(e.count);
+  for (int f = 0; f < e.count; ++f)
+  {
+    if (f % reportInterval == reportInterval - 1 && !reader.report(monitor))
+      return false;
+    if (fast
+      && reader.remaining() >= 13
+      && *(const uint8_t*)reader.position() == 3)
+    {
+      auto p = reader.position() + 1;
+      auto& t = data.triangles[Position].add();
+
+      if (!reader.swap())
+        memcpy(t.v, p, 12);
+      else
+        for (int c = 0; c < 3; ++c)
+          t.v[c] = loadValue<int32_t>(p + 4 * c, true);
+      reader.skip(13);
+      if (unsigned(t.v[0]) >= unsigned(nv)
+        || unsigned(t.v[1]) >= unsigned(nv)
+        || unsigned(t.v[2]) >= unsigned(nv))
+        data.triangles[Position].resize(data.numberOfTriangles() - 1);
+      continue;
+    }
+    face.clear();
+    for (int k = 0; k < np; ++k)
+    {
+      const auto& q = e.properties[k];
+      double count{1};
+
+      if (q.countType != PLYType::Invalid && !reader.read(q.countType, count))
+        return false;
+      for (auto m = int(count); m > 0; --m)
+      {
+        double value;
+
+        if (!reader.read(q.type, value))
+          return false;
+        if (k == indices)
+          face.push_back(int(value));
       }
+    }
+
+    auto n = int(face.size());
+    auto valid = n >= 3;
+
+    for (int c = 0; valid && c < n; ++c)
+      valid = unsigned(face[c]) < unsigned(nv);
+    if (!valid)
+      continue;
 
-      default:
-        fgets(line, lineSize, file);
+    auto first = data.numberOfTriangles();
+
+    for (int c = 2; c < n; ++c)
+      data.triangles[Position].add().setVertices(face[0], face[c - 1], face[c]);
+    if (n > 3)
+    {
+      data.polygons.add() = first;
+      data.polygons.add() = n;
     }
+  }
+  return true;
+}
+
+// Makes one mesh vertex of each distinct position of the 3 corners of
+// each triangle in corners.
+void
+weldSTLVertices(Buffer<vec3f>& corners, TriangleMesh::Data& data)
+{
+  const auto nt = corners.size() / 3;
+  uint32_t capacity{1024};
+
+  // The load factor is at most 3/4, even if no corners are shared
+  while (capacity < uint32_t(4 * nt))
+    capacity *= 2;
+
+  const auto mask = capacity - 1;
+  std::vector<int> table(capacity, -1);
+  Buffer<vec3f> vertices;
+  auto triangles = new Triangle[nt];
+
+  vertices.reserve(nt / 2 + 3);
+  for (int i = 0; i < 3 * nt; ++i)
+  {
+    auto p = corners[i];
+    int k[3];
+
+    // Makes -0 equal to +0
+    p += vec3f{0.0f};
+    memcpy(k, &p, sizeof(k));
+
+    auto h = hashTriple(k) & mask;
+    int v;
+
+    while ((v = table[h]) >= 0)
+    {
+      if (memcmp(&vertices[v], &p, sizeof(vec3f)) == 0)
+        break;
+      h = (h + 1) & mask;
+    }
+    if (v < 0)
+    {
+      table[h] = v = vertices.size();
+      vertices.add() = p;
+    }
+    triangles[i / 3].v[i % 3] = v;
+  }
+  data.numberOfVertices = vertices.size();
+  data.vertices = vertices.release();
+  data.vertexNormals = nullptr;
+  data.numberOfTriangles = nt;
+  data.triangles = triangles;
+}
+
+bool
+readSTLData(const char* s, const char* end, Buffer<vec3f>& corners)
+{
+  const auto size = size_t(end - s);
+
+  // Binary STL: 80-byte header, triangle count and 50-byte triangles.
+  // Binary files may also begin with "solid", so check the size first
+  if (size >= 84)
+  {
+    const auto swap = !isHostLittleEndian();
+    auto nt = loadValue<uint32_t>(s + 80, swap);
+
+    if (size == 84 + 50 * size_t(nt) && nt <= uint32_t(INT_MAX / 3))
+    {
+      auto p = s + 84 + 12;
+
+      corners.resize(int(3 * nt));
+      for (uint32_t t = 0; t < nt; ++t, p += 50)
+        if (!swap)
+          memcpy(&corners[3 * t], p, 36);
+        else
+          for (int i = 0; i < 9; ++i)
+            corners[3 * t + i / 3][i % 3] = loadValue<float>(p + 4 * i, true);
+      return true;
+    }
+  }
+
+  auto t = nextToken(s, end);
+
+  if (t != "solid")
+    return false;
+  while (s < end)
+  {
+    t = nextToken(s, end);
+    if (t == "vertex")
+      s = readOBJFloats(s, end, &corners.add().x, 3);
+    else if (t.empty())
+      s = skipLine(s, end);
+  }
+  // Drop an incomplete last triangle
+  corners.resize(corners.size() / 3 * 3);
+  return true;
 }
 
 } // end namespace internal
@@ -234,29 +1756,201 @@ readMeshData(FILE* file, TriangleMesh::Data& data)
 // MeshReader implementation
 // ==========
 TriangleMesh*
-MeshReader::readOBJ(const char* filename)
+MeshReader::readOBJ(const char* filename,
+  int numberOfThreads,
+  const ProgressCallback& progress)
 {
-  FILE* file;
+  MappedFile file{filename};
 
-  fopen_s(&file, filename, "r");
-  if (file == nullptr)
+  if (!file.isOpen())
     return nullptr;
+  printf("Reading Wavefront OBJ file %s...\n", filename);
+  if (numberOfThreads <= 0)
+    numberOfThreads = parallel::defaultNumberOfThreads();
+
+  internal::OBJData objData;
+  internal::ReadMonitor monitor{progress, file.size()};
+
+  if (numberOfThreads > 1 && file.size() >= 2 * internal::minChunkSize)
+  {
+    if (!internal::readOBJDataParallel(file.data(),
+      file.end(),
+      objData,
+      numberOfThreads,
+      monitor))
+      return nullptr;
+  }
+  else
+  {
+    // Guess the buffer sizes from the file size (about 32 bytes per line)
+    objData.vertices.reserve(int(file.size() / 96));
+    objData.triangles[internal::Position].reserve(int(file.size() / 48));
+    if (!internal::readOBJSlices(file.data(), file.end(), objData, monitor))
+      return nullptr;
+    internal::triangulateOBJPolygons(objData, objData, 0, numberOfThreads);
+  }
 
   TriangleMesh::Data data;
 
-  internal::readMeshSize(file, data);
-  data.vertices = new vec3f[data.numberOfVertices];
-  data.vertexNormals = nullptr;
-  data.triangles = new TriangleMesh::Triangle[data.numberOfTriangles];
-  rewind(file);
-  printf("Reading Wavefront OBJ file %s...\n", filename);
-  internal::readMeshData(file, data);
-  fclose(file);
+  if (!internal::makeMeshData(objData, data))
+    return nullptr;
 
   auto mesh = new TriangleMesh{std::move(data)};
 
-  mesh->computeNormals();
+  // Compute the normals only if the file has none
+  if (!mesh->hasVertexNormals())
+    mesh->computeNormals();
   return mesh;
 }
 
+bool
+MeshReader::streamOBJ(const char* filename, Sink& sink, int batchSize)
+{
+  MappedFile file{filename};
+
+  if (!file.isOpen())
+    return false;
+  if (batchSize < 1)
+    batchSize = 1;
+
+  internal::OBJData data;
+
+  data.vertices.reserve(std::min(batchSize, 64 * 1024));
+  data.triangles[internal::Position].reserve(std::min(batchSize, 64 * 1024));
+  internal::readOBJData(file.data(), file.end(), data, [&](auto& data)
+  {
+    internal::flushOBJData(data, sink, batchSize);
+  });
+  internal::flushOBJData(data, sink, batchSize, true);
+  return true;
+}
+
+TriangleMesh*
+MeshReader::readPLY(const char* filename, const ProgressCallback& progress)
+{
+  MappedFile file{filename};
+
+  if (!file.isOpen())
+    return nullptr;
+
+  auto s = (const char*)file.data();
+  auto end = file.end();
+  internal::PLYFormat format;
+  std::vector<internal::PLYElement> elements;
+
+  if (!internal::readPLYHeader(s, end, format, elements))
+    return nullptr;
+  printf("Reading PLY file %s...\n", filename);
+
+  internal::PLYElementReader reader{format, file.data(), s, end};
+  internal::ReadMonitor monitor{progress, file.size()};
+  internal::OBJData objData;
+  auto hasVertices = false;
+
+  for (const auto& e : elements)
+  {
+    auto ok = true;
+
+    if (e.name == "vertex" && !hasVertices)
+      ok = hasVertices = internal::readPLYVertices(reader, e, objData, monitor);
+    else if (e.name == "face" && hasVertices)
+      ok = internal::readPLYFaces(reader, e, objData, monitor);
+    else
+      for (int i = 0; ok && i < e.count; ++i)
+        ok = reader.skip(e);
+    if (!ok || !reader.report(monitor))
+      return nullptr;
+  }
+  if (!hasVertices)
+    return nullptr;
+  // Count the bytes after the last element as read
+  reader.skip(reader.remaining());
+  if (!reader.report(monitor))
+    return nullptr;
+  internal::triangulateOBJPolygons(objData, objData, 0, 0);
+
+  TriangleMesh::Data data;
+  auto nv = objData.vertices.size();
+
+  data.numberOfVertices = nv;
+  data.vertices = objData.vertices.release();
+  data.vertexNormals = objData.normals.size() == nv ?
+    objData.normals.release() : nullptr;
+  data.uv = objData.uv.size() == nv ? objData.uv.release() : nullptr;
+  data.numberOfTriangles = objData.numberOfTriangles();
+  data.triangles = objData.triangles[internal::Position].release();
+
+  auto mesh = new TriangleMesh{std::move(data)};
+
+  if (!mesh->hasVertexNormals())
+    mesh->computeNormals();
+  return mesh;
+}
+
+TriangleMesh*
+MeshReader::readSTL(const char* filename, const ProgressCallback& progress)
+{
+  MappedFile file{filename};
+
+  if (!file.isOpen())
+    return nullptr;
+
+  internal::Buffer<vec3f> corners;
+
+  internal::ReadMonitor monitor{progress, file.size()};
+
+  if (!internal::readSTLData(file.data(), file.end(), corners)
+    || !monitor.advance(file.size()))
+    return nullptr;
+  printf("Reading STL file %s...\n", filename);
+
+  TriangleMesh::Data data;
+
+  internal::weldSTLVertices(corners, data);
+
+  Reference<TriangleMesh> mesh{new TriangleMesh{std::move(data)}};
+
+  // STL facet normals are flat, so compute smooth ones from the faces,
+  // keeping the sharp edges of CAD models sharp
+  return mesh->splitCreases(stlCreaseAngle);
+}
+
+namespace internal
+{ // begin namespace internal
+
+inline bool
+hasExtension(const char* filename, const char* extension)
+{
+  auto n = strlen(filename);
+  auto m = strlen(extension);
+
+  if (n < m)
+    return false;
+  filename += n - m;
+  for (size_t i = 0; i < m; ++i)
+    if (tolower((unsigned char)filename[i]) != extension[i])
+      return false;
+  return true;
+}
+
+} // end namespace internal
+
+bool
+MeshReader::isSupported(const char* filename)
+{
+  return internal::hasExtension(filename, ".obj")
+    || internal::hasExtension(filename, ".ply")
+    || internal::hasExtension(filename, ".stl");
+}
+
+TriangleMesh*
+MeshReader::read(const char* filename, const ProgressCallback& progress)
+{
+  if (internal::hasExtension(filename, ".ply"))
+    return readPLY(filename, progress);
+  if (internal::hasExtension(filename, ".stl"))
+    return readSTL(filename, progress);
+  return readOBJ(filename, 0, progress);
+}
+
 } // end namespace cg
@@ -0,0 +1,539 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: MeshSimplifier.cpp
+// ========
+// Source file for mesh simplifier.
+//
+// Last revision: 18/10/2026
+
+#include "utils/MeshOptimizer.h"
+#include "utils/MeshSimplifier.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <queue>
+
+namespace cg
+{ // begin namespace cg
+
+namespace internal
+{ // begin namespace internal
+
+//
+// Quadric error of a point, i.e., p'Ap + 2b'p + c, where A is a
+// symmetric 3x3 matrix
+//
+struct Quadric
+{
+  double a00{}, a01{}, a02{}, a11{}, a12{}, a22{};
+  double b0{}, b1{}, b2{};
+  double c{};
+
+  Quadric() = default;
+
+  // Squared distance to the plane n.p + d = 0, with n a unit vector
+  Quadric(const vec3f& n, float d):
+    a00{n.x * n.x}, a01{n.x * n.y}, a02{n.x * n.z},
+    a11{n.y * n.y}, a12{n.y * n.z}, a22{n.z * n.z},
+    b0{n.x * d}, b1{n.y * d}, b2{n.z * d},
+    c{d * d}
+  {
+    // do nothing
+  }
+
+  Quadric& operator +=(const Quadric& q)
+  {
+    a00 += q.a00;
+    a01 += q.a01;
+    a02 += q.a02;
+    a11 += q.a11;
+    a12 += q.a12;
+    a22 += q.a22;
+    b0 += q.b0;
+    b1 += q.b1;
+    b2 += q.b2;
+    c += q.c;
+    return *this;
+  }
+
+  Quadric operator +(const Quadric& q) const
+  {
+    return Quadric{*this} += q;
+  }
+
+  double operator ()(const vec3f& p) const
+  {
+    const double x{p.x};
+    const double y{p.y};
+    const double z{p.z};
+
+    return x * (a00 * x + 2 * (a01 * y + a02 * z + b0))
+      + y * (a11 * y + 2 * (a12 * z + b1))
+      + z * (a22 * z + 2 * b2)
+      + c;
+  }
+
+  // Computes the point of minimum error, if A is not nearly singular
+  bool minimize(vec3f& p) const
+  {
+    const auto c00 = a11 * a22 - a12 * a12;
+    const auto c01 = a02 * a12 - a01 * a22;
+    const auto c02 = a01 * a12 - a02 * a11;
+    const auto det = a00 * c00 + a01 * c01 + a02 * c02;
+    const auto s = std::max({a00, a11, a22});
+
+    if (std::abs(det) <= 1e-9 * s * s * s)
+      return false;
+
+    const auto c11 = a00 * a22 - a02 * a02;
+    const auto c12 = a01 * a02 - a00 * a12;
+    const auto c22 = a00 * a11 - a01 * a01;
+    const auto k = -1 / det;
+
+    p.x = float(k * (c00 * b0 + c01 * b1 + c02 * b2));
+    p.y = float(k * (c01 * b0 + c11 * b1 + c12 * b2));
+    p.z = float(k * (c02 * b0 + c12 * b1 + c22 * b2));
+    return true;
+  }
+
+}; // Quadric
+
+//
+// Edge collapse simplifier. Collapsing the edge (a, b) moves a to the
+// point of minimum quadric error and removes b
+//
+class QuadricSimplifier
+{
+public:
+  QuadricSimplifier(const TriangleMesh::Data& data);
+
+  // Collapses edges until there are at most n triangles
+  void simplify(int n);
+
+  int numberOfTriangles() const
+  {
+    return _nt;
+  }
+
+  // Square root of the largest quadric error of a collapse so far
+  float error() const
+  {
+    return float(sqrt(_maxError));
+  }
+
+  TriangleMesh* makeMesh() const;
+
+private:
+  struct Collapse
+  {
+    double error;
+    int v[2];
+    int stamps[2];
+    vec3f p;
+
+    bool operator >(const Collapse& other) const
+    {
+      return error > other.error;
+    }
+
+  }; // Collapse
+
+  using CollapseQueue = std::priority_queue<Collapse,
+    std::vector<Collapse>,
+    std::greater<Collapse>>;
+
+  std::vector<vec3f> _p;
+  std::vector<vec3f> _n;
+  std::vector<vec2f> _uv;
+  std::vector<Quadric> _q;
+  // Removed triangles have v[0] < 0
+  std::vector<TriangleMesh::Triangle> _t;
+  // Triangles of each vertex, including removed ones until cleaned up
+  std::vector<std::vector<int>> _vt;
+  // Number of times each vertex was moved (-1 if removed)
+  std::vector<int> _stamps;
+  std::vector<int> _marks;
+  int _mark{0};
+  CollapseQueue _collapses;
+  int _nt;
+  double _maxError{0};
+
+  bool removed(int t) const
+  {
+    return _t[t].v[0] < 0;
+  }
+
+  bool hasVertex(int t, int v) const
+  {
+    const auto& i = _t[t].v;
+    return i[0] == v || i[1] == v || i[2] == v;
+  }
+
+  void addCollapse(int a, int b);
+  bool canCollapse(const Collapse&);
+  void collapse(const Collapse&);
+
+}; // QuadricSimplifier
+
+QuadricSimplifier::QuadricSimplifier(const TriangleMesh::Data& data):
+  _p(data.vertices, data.vertices + data.numberOfVertices),
+  _q(data.numberOfVertices),
+  _t(data.triangles, data.triangles + data.numberOfTriangles),
+  _vt(data.numberOfVertices),
+  _stamps(data.numberOfVertices),
+  _marks(data.numberOfVertices),
+  _nt{data.numberOfTriangles}
+{
+  const auto nv = data.numberOfVertices;
+
+  if (data.vertexNormals != nullptr)
+    _n.assign(data.vertexNormals, data.vertexNormals + nv);
+  if (data.uv != nullptr)
+    _uv.assign(data.uv, data.uv + nv);
+  for (int i = 0; i < _nt; ++i)
+  {
+    const auto& v = _t[i].v;
+    const auto N = (_p[v[1]] - _p[v[0]]).cross(_p[v[2]] - _p[v[0]]);
+    const auto n = N.versor();
+    const Quadric q{n, -n.dot(_p[v[0]])};
+
+    for (int k = 0; k < 3; ++k)
+    {
+      _q[v[k]] += q;
+      _vt[v[k]].push_back(i);
+    }
+  }
+  // The plane through each border edge perpendicular to its triangle
+  // keeps the borders (and attribute seams) from shrinking
+  for (int i = 0; i < _nt; ++i)
+  {
+    const auto& v = _t[i].v;
+    const auto N = (_p[v[1]] - _p[v[0]]).cross(_p[v[2]] - _p[v[0]]);
+
+    for (int k = 0; k < 3; ++k)
+    {
+      const auto a = v[k];
+      const auto b = v[(k + 1) % 3];
+      auto count = 0;
+
+      for (auto t : _vt[a])
+        count += hasVertex(t, b);
+      if (count == 1)
+      {
+        const auto n = (_p[b] - _p[a]).cross(N).versor();
+        const Quadric q{n, -n.dot(_p[a])};
+
+        _q[a] += q;
+        _q[b] += q;
+      }
+    }
+  }
+  for (int a = 0; a < nv; ++a)
+  {
+    ++_mark;
+    for (auto t : _vt[a])
+      for (auto b : _t[t].v)
+        if (b > a && _marks[b] != _mark)
+        {
+          _marks[b] = _mark;
+          addCollapse(a, b);
+        }
+  }
+}
+
+void
+QuadricSimplifier::addCollapse(int a, int b)
+{
+  const auto q = _q[a] + _q[b];
+  const auto& pa = _p[a];
+  const auto& pb = _p[b];
+  const auto pm = (pa + pb) * 0.5f;
+  Collapse c{q(pa), {a, b}, {_stamps[a], _stamps[b]}, pa};
+  vec3f p;
+
+  auto test = [&](const vec3f& p)
+  {
+    if (const auto e = q(p); e < c.error)
+    {
+      c.error = e;
+      c.p = p;
+    }
+  };
+
+  test(pb);
+  test(pm);
+  // The point of minimum error may be far away if A is ill conditioned
+  if (q.minimize(p) && (p - pm).squaredNorm() <= (pb - pa).squaredNorm())
+    test(p);
+  c.error = std::max(c.error, 0.0);
+  _collapses.push(c);
+}
+
+bool
+QuadricSimplifier::canCollapse(const Collapse& c)
+{
+  const auto a = c.v[0];
+  const auto b = c.v[1];
+
+  if (_stamps[a] != c.stamps[0] || _stamps[b] != c.stamps[1])
+    return false;
+
+  // Link condition: the vertices adjacent to both a and b must be the
+  // opposite vertices of the triangles of the edge (a, b)
+  auto m = _mark += 2;
+  int shared{0};
+  int common{0};
+
+  for (auto t : _vt[a])
+    if (!removed(t))
+      for (auto v : _t[t].v)
+        _marks[v] = m - 1;
+  for (auto t : _vt[b])
+    if (!removed(t))
+    {
+      shared += hasVertex(t, a);
+      for (auto v : _t[t].v)
+        if (v != a && v != b && _marks[v] == m - 1)
+        {
+          _marks[v] = m;
+          ++common;
+        }
+    }
+  if (common != shared)
+    return false;
+
+  // The triangles moved with a or b must not flip
+  for (auto v : c.v)
+    for (auto t : _vt[v])
+    {
+      if (removed(t) || (hasVertex(t, a) && hasVertex(t, b)))
+        continue;
+
+      const auto& i = _t[t].v;
+      const vec3f* p[3]{&_p[i[0]], &_p[i[1]], &_p[i[2]]};
+      const auto n = (*p[1] - *p[0]).cross(*p[2] - *p[0]);
+
+      for (auto& q : p)
+        if (q == &_p[v])
+          q = &c.p;
+
+      const auto N = (*p[1] - *p[0]).cross(*p[2] - *p[0]);
+
+      if (N.dot(n) < 0.2f * N.length() * n.length())
+        return false;
+    }
+  return true;
+}
+
+void
+QuadricSimplifier::collapse(const Collapse& c)
+{
+  const auto a = c.v[0];
+  const auto b = c.v[1];
+  const auto ab = _p[b] - _p[a];
+  const auto d = ab.squaredNorm();
+  const auto s = d > 0 ? math::clamp((c.p - _p[a]).dot(ab) / d, 0.0f, 1.0f) : 0;
+
+  if (!_n.empty())
+    _n[a] = (_n[a] * (1 - s) + _n[b] * s).versor();
+  if (!_uv.empty())
+    _uv[a] = _uv[a] * (1 - s) + _uv[b] * s;
+  _p[a] = c.p;
+  _q[a] += _q[b];
+  ++_stamps[a];
+  _stamps[b] = -1;
+  for (auto t : _vt[b])
+  {
+    if (removed(t))
+      continue;
+    if (hasVertex(t, a))
+    {
+      _t[t].v[0] = -1;
+      --_nt;
+      continue;
+    }
+    for (auto& v : _t[t].v)
+      if (v == b)
+        v = a;
+    _vt[a].push_back(t);
+  }
+  _vt[b] = {};
+
+  auto& vt = _vt[a];
+
+  vt.erase(std::remove_if(vt.begin(), vt.end(), [this](int t)
+  {
+    return removed(t);
+  }), vt.end());
+  _maxError = std::max(_maxError, c.error);
+  ++_mark;
+  for (auto t : vt)
+    for (auto v : _t[t].v)
+      if (v != a && _marks[v] != _mark)
+      {
+        _marks[v] = _mark;
+        addCollapse(a, v);
+      }
+}
+
+void
+QuadricSimplifier::simplify(int n)
+{
+  while (_nt > n && !_collapses.empty())
+  {
+    const auto c = _collapses.top();
+
+    _collapses.pop();
+    if (canCollapse(c))
+      collapse(c);
+  }
+}
+
+TriangleMesh*
+QuadricSimplifier::makeMesh() const
+{
+  std::vector<int> remap(_p.size(), -1);
+  TriangleMesh::Data data{};
+
+  for (const auto& t : _t)
+    if (t.v[0] >= 0)
+      for (auto v : t.v)
+        if (remap[v] < 0)
+          remap[v] = data.numberOfVertices++;
+  data.numberOfTriangles = _nt;
+  data.vertices = new vec3f[data.numberOfVertices];
+  data.vertexNormals = new vec3f[data.numberOfVertices];
+  if (!_uv.empty())
+    data.uv = new vec2f[data.numberOfVertices];
+  data.triangles = new TriangleMesh::Triangle[_nt];
+  for (size_t i = 0; i < remap.size(); ++i)
+  {
+    const auto v = remap[i];
+
+    if (v < 0)
+      continue;
+    data.vertices[v] = _p[i];
+    if (!_n.empty())
+      data.vertexNormals[v] = _n[i];
+    if (data.uv != nullptr)
+      data.uv[v] = _uv[i];
+  }
+
+  auto triangle = data.triangles;
+
+  for (const auto& t : _t)
+    if (t.v[0] >= 0)
+      (triangle++)->setVertices(remap[t.v[0]], remap[t.v[1]], remap[t.v[2]]);
+  MeshOptimizer::optimize(data);
+
+  auto mesh = new TriangleMesh{std::move(data)};
+
+  if (_n.empty())
+    mesh->computeNormals();
+  return mesh;
+}
+
+} // end namespace internal
+
+
+/////////////////////////////////////////////////////////////////////
+//
+// MeshSimplifier implementation
+// ==============
+void
+MeshSimplifier::Statistics::print(const char* s, FILE* f) const
+{
+  fprintf(f,
+    "%s: ratio %g, triangles %d, error %g, time %.2f ms\n",
+    s,
+    ratio,
+    numberOfTriangles,
+    error,
+    seconds * 1000);
+}
+
+TriangleMesh*
+MeshSimplifier::simplify(const TriangleMesh& mesh,
+  float ratio,
+  Statistics* statistics)
+{
+  using clock = std::chrono::steady_clock;
+
+  const auto start = clock::now();
+  const auto& data = mesh.data();
+  internal::QuadricSimplifier simplifier{data};
+
+  simplifier.simplify(int(ratio * data.numberOfTriangles));
+
+  auto m = simplifier.makeMesh();
+
+  if (statistics != nullptr)
+  {
+    const auto diagonal = mesh.bounds().diagonalLength();
+    const std::chrono::duration<double> seconds{clock::now() - start};
+
+    *statistics = {ratio,
+      simplifier.numberOfTriangles(),
+      diagonal > 0 ? simplifier.error() / diagonal : 0,
+      seconds.count()};
+  }
+  return m;
+}
+
+std::vector<MeshSimplifier::Statistics>
+MeshSimplifier::buildLODs(TriangleMesh& mesh, std::vector<float> ratios)
+{
+  using clock = std::chrono::steady_clock;
+
+  auto start = clock::now();
+  const auto& data = mesh.data();
+  const auto diagonal = mesh.bounds().diagonalLength();
+  internal::QuadricSimplifier simplifier{data};
+  std::vector<Statistics> statistics;
+
+  std::sort(ratios.begin(), ratios.end(), std::greater<float>());
+  mesh.lods.clear();
+  for (auto ratio : ratios)
+  {
+    simplifier.simplify(int(ratio * data.numberOfTriangles));
+
+    const auto error = diagonal > 0 ? simplifier.error() / diagonal : 0;
+
+    mesh.lods.push_back({simplifier.makeMesh(), error});
+
+    const auto end = clock::now();
+    const std::chrono::duration<double> seconds{end - start};
+
+    statistics.push_back({ratio,
+      simplifier.numberOfTriangles(),
+      error,
+      seconds.count()});
+    start = end;
+  }
+  return statistics;
+}
+
+} // end namespace cg
@@ -31,6 +31,7 @@
 // Last revision: 02/06/2019
 
 #include "geometry/MeshSweeper.h"
+#include <algorithm>
 #include <vector>
 
 namespace cg
@@ -39,53 +40,61 @@ namespace cg
 namespace internal
 { // begin namespace internal
 
-inline void
-setBoxVertices(vec3f* v)
+// Box vertices, vertex normals, and triangles, built at compile time
+constexpr vec3f p1{-1, -1, -1};
+constexpr vec3f p2{+1, -1, -1};
+constexpr vec3f p3{+1, +1, -1};
+constexpr vec3f p4{-1, +1, -1};
+constexpr vec3f p5{-1, -1, +1};
+constexpr vec3f p6{+1, -1, +1};
+constexpr vec3f p7{+1, +1, +1};
+constexpr vec3f p8{-1, +1, +1};
+
+constexpr vec3f boxVertices[]
 {
-  const vec3f p1{-1, -1, -1};
-  const vec3f p2{+1, -1, -1};
-  const vec3f p3{+1, +1, -1};
-  const vec3f p4{-1, +1, -1};
-  const vec3f p5{-1, -1, +1};
-  const vec3f p6{+1, -1, +1};
-  const vec3f p7{+1, +1, +1};
-  const vec3f p8{-1, +1, +1};
-
-  v[ 0] = p1; v[ 1] = p5; v[ 2] = p8; v[ 3] = p4; // x = -1
-  v[ 4] = p2; v[ 5] = p3; v[ 6] = p7; v[ 7] = p6; // x = +1
-  v[ 8] = p1; v[ 9] = p2; v[10] = p6; v[11] = p5; // y = -1
-  v[12] = p4; v[13] = p8; v[14] = p7; v[15] = p3; // y = +1
-  v[16] = p1; v[17] = p4; v[18] = p3; v[19] = p2; // z = -1
-  v[20] = p5; v[21] = p6; v[22] = p7; v[23] = p8; // z = +1
-}
-
-inline void
-setBoxVertexNormals(vec3f* n)
+  p1, p5, p8, p4, // x = -1
+  p2, p3, p7, p6, // x = +1
+  p1, p2, p6, p5, // y = -1
+  p4, p8, p7, p3, // y = +1
+  p1, p4, p3, p2, // z = -1
+  p5, p6, p7, p8  // z = +1
+};
+
+constexpr vec3f n1{-1, 0, 0};
+constexpr vec3f n2{+1, 0, 0};
+constexpr vec3f n3{0, -1, 0};
+constexpr vec3f n4{0, +1, 0};
+constexpr vec3f n5{0, 0, -1};
+constexpr vec3f n6{0, 0, +1};
+
+constexpr vec3f boxVertexNormals[]
 {
-  const vec3f n1{-1, 0, 0};
-  const vec3f n2{+1, 0, 0};
-  const vec3f n3{0, -1, 0};
-  const vec3f n4{0, +1, 0};
-  const vec3f n5{0, 0, -1};
-  const vec3f n6{0, 0, +1};
-
-  n[ 0] = n[ 1] = n[ 2] = n[ 3] = n1; // x = -1
-  n[ 4] = n[ 5] = n[ 6] = n[ 7] = n2; // x = +1
-  n[ 8] = n[ 9] = n[10] = n[11] = n3; // y = -1
-  n[12] = n[13] = n[14] = n[15] = n4; // y = +1
-  n[16] = n[17] = n[18] = n[19] = n5; // z = -1
-  n[20] = n[21] = n[22] = n[23] = n6; // z = +1
-}
-
-inline void
-setBoxTriangles(TriangleMesh::Triangle* t)
+  n1, n1, n1, n1, // x = -1
+  n2, n2, n2, n2, // x = +1
+  n3, n3, n3, n3, // y = -1
+  n4, n4, n4, n4, // y = +1
+  n5, n5, n5, n5, // z = -1
+  n6, n6, n6, n6  // z = +1
+};
+
+constexpr TriangleMesh::Triangle boxTriangles[]
+{
+  { 0,  1,  2}, { 2,  3,  0},
+  { 4,  5,  7}, { 5,  6,  7},
+  { 8,  9, 11}, { 9, 10, 11},
+  {12, 13, 14}, {14, 15, 12},
+  {16, 17, 19}, {17, 18, 19},
+  {20, 21, 22}, {22, 23, 20}
+};
+
+template <typename T, int n>
+inline T*
+copyOf(const T (&a)[n])
 {
-  t[ 0].setVertices( 0,  1,  2); t[ 1].setVertices( 2,  3,  0);
-  t[ 2].setVertices( 4,  5,  7); t[ 3].setVertices( 5,  6,  7);
-  t[ 4].setVertices( 8,  9, 11); t[ 5].setVertices( 9, 10, 11);
-  t[ 6].setVertices(12, 13, 14); t[ 7].setVertices(14, 15, 12);
-  t[ 8].setVertices(16, 17, 19); t[ 9].setVertices(17, 18, 19);
-  t[10].setVertices(20, 21, 22); t[11].setVertices(22, 23, 20);
+  auto c = new T[n];
+
+  std::copy(a, a + n, c);
+  return c;
 }
 
 } // end namespace internal
@@ -98,18 +107,13 @@ setBoxTriangles(TriangleMesh::Triangle* t)
 TriangleMesh*
 MeshSweeper::makeBox()
 {
-  const int nv{24}; // number of vertices and normals
-  const int nt{12}; // number of triangles
   TriangleMesh::Data data;
 
-  data.numberOfVertices = nv;
-  data.vertices = new vec3f[nv];
-  internal::setBoxVertices(data.vertices);
-  data.vertexNormals = new vec3f[nv];
-  internal::setBoxVertexNormals(data.vertexNormals);
-  data.numberOfTriangles = nt;
-  data.triangles = new TriangleMesh::Triangle[nt];
-  internal::setBoxTriangles(data.triangles);
+  data.numberOfVertices = 24;
+  data.vertices = internal::copyOf(internal::boxVertices);
+  data.vertexNormals = internal::copyOf(internal::boxVertexNormals);
+  data.numberOfTriangles = 12;
+  data.triangles = internal::copyOf(internal::boxTriangles);
   return new TriangleMesh{std::move(data)};
 }
 
@@ -183,7 +187,7 @@ MeshSweeper::makeSphere(int ns)
 
   const auto np = ns + 1;
   const auto nv = np * (np + 1); // number of vertices
-  const auto nt = 2 * np * ns; // number of triangles
+  const auto nt = 2 * (np - 1) * ns; // number of triangles
   TriangleMesh::Data data;
 
   data.numberOfVertices = nv;
@@ -219,7 +223,9 @@ MeshSweeper::makeSphere(int ns)
 
   auto triangle = data.triangles;
 
-  for (int p = 0; p <= np; ++p)
+  // The first and the last bands have no triangles with two vertices
+  // on a pole
+  for (int p = 0; p < np; ++p)
   {
     auto i = p * np;
     auto j = i + np;
@@ -230,7 +236,7 @@ MeshSweeper::makeSphere(int ns)
 
       if (p != 0)
         triangle++->setVertices(i, j, k);
-      if (p != np)
+      if (p != np - 1)
         triangle++->setVertices(k, j, j + 1);
     }
   }
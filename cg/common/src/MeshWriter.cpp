@@ -0,0 +1,331 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: MeshWriter.cpp
+// ========
+// Source file for mesh writer.
+//
+// Last revision: 18/10/2026
+
+#include "utils/MeshWriter.h"
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace cg
+{ // begin namespace cg
+
+namespace internal
+{ // begin namespace internal
+
+//
+// Output file with a large buffer, flushed only when full
+//
+class MeshOutputFile
+{
+public:
+  MeshOutputFile(const char* filename):
+    _ok{fopen_s(&_file, filename, "wb") == 0},
+    _buffer(bufferSize),
+    _size{0}
+  {
+    if (!_ok)
+      _file = nullptr;
+  }
+
+  ~MeshOutputFile()
+  {
+    if (_file != nullptr)
+      fclose(_file);
+  }
+
+  bool isOpen() const
+  {
+    return _file != nullptr;
+  }
+
+  // Flushes the buffer and closes the file. Returns false if any
+  // write failed.
+  bool close()
+  {
+    flush();
+    if (_file != nullptr && fclose(_file) != 0)
+      _ok = false;
+    _file = nullptr;
+    return _ok;
+  }
+
+  // Returns a pointer to at least n free bytes of the buffer
+  char* reserve(size_t n)
+  {
+    if (_size + n > bufferSize)
+      flush();
+    return _buffer.data() + _size;
+  }
+
+  void commit(char* end)
+  {
+    _size = size_t(end - _buffer.data());
+  }
+
+  void write(const void* data, size_t n)
+  {
+    if (n > bufferSize)
+    {
+      flush();
+      _ok &= fwrite(data, 1, n, _file) == n;
+    }
+    else
+    {
+      memcpy(reserve(n), data, n);
+      _size += n;
+    }
+  }
+
+  void write(const char* s)
+  {
+    write(s, strlen(s));
+  }
+
+private:
+  static constexpr size_t bufferSize = 1 << 20;
+
+  FILE* _file;
+  bool _ok;
+  std::vector<char> _buffer;
+  size_t _size;
+
+  void flush()
+  {
+    if (_size > 0)
+      _ok &= fwrite(_buffer.data(), 1, _size, _file) == _size;
+    _size = 0;
+  }
+
+}; // MeshOutputFile
+
+// Maximum number of characters of a float or int written by to_chars
+constexpr size_t maxNumberSize = 32;
+
+inline char*
+writeNumber(char* s, float value)
+{
+  return std::to_chars(s, s + maxNumberSize, value).ptr;
+}
+
+inline char*
+writeNumber(char* s, int value)
+{
+  return std::to_chars(s, s + maxNumberSize, value).ptr;
+}
+
+template <typename V>
+inline void
+writeOBJLine(MeshOutputFile& file, const char* tag, const V& v, int n)
+{
+  auto s = file.reserve(8 + n * (maxNumberSize + 1));
+
+  while (*tag)
+    *s++ = *tag++;
+  for (int i = 0; i < n; ++i)
+  {
+    *s++ = ' ';
+    s = writeNumber(s, v[i]);
+  }
+  *s++ = '\n';
+  file.commit(s);
+}
+
+inline bool
+isHostLittleEndian()
+{
+  const uint16_t one{1};
+  return *(const unsigned char*)&one == 1;
+}
+
+inline bool
+hasExtension(const char* filename, const char* extension)
+{
+  auto n = strlen(filename);
+  auto m = strlen(extension);
+
+  if (n < m)
+    return false;
+  filename += n - m;
+  for (size_t i = 0; i < m; ++i)
+    if (tolower((unsigned char)filename[i]) != extension[i])
+      return false;
+  return true;
+}
+
+} // end namespace internal
+
+
+/////////////////////////////////////////////////////////////////////
+//
+// MeshWriter implementation
+// ==========
+bool
+MeshWriter::writeOBJ(const TriangleMesh& mesh, const char* filename)
+{
+  internal::MeshOutputFile file{filename};
+
+  if (!file.isOpen())
+    return false;
+
+  const auto& data = mesh.data();
+  const auto nv = data.numberOfVertices;
+  const auto hasNormals = data.vertexNormals != nullptr;
+  const auto hasUV = data.uv != nullptr;
+
+  file.write("# cg mesh\n");
+  for (int i = 0; i < nv; ++i)
+    internal::writeOBJLine(file, "v", data.vertices[i], 3);
+  if (hasUV)
+    for (int i = 0; i < nv; ++i)
+      internal::writeOBJLine(file, "vt", data.uv[i], 2);
+  if (hasNormals)
+    for (int i = 0; i < nv; ++i)
+      internal::writeOBJLine(file, "vn", data.vertexNormals[i], 3);
+
+  // Each vertex has its own texture coordinates and normal, so the
+  // attribute indices of a corner are equal to its position index
+  const auto nt = data.numberOfTriangles;
+
+  for (int i = 0; i < nt; ++i)
+  {
+    auto s = file.reserve(4 + 3 * (3 * internal::maxNumberSize + 3));
+
+    *s++ = 'f';
+    for (auto v : data.triangles[i].v)
+    {
+      *s++ = ' ';
+
+      auto t = s;
+
+      s = internal::writeNumber(s, v + 1);
+      if (hasUV || hasNormals)
+      {
+        auto n = size_t(s - t);
+
+        *s++ = '/';
+        if (hasUV)
+          s = (char*)memcpy(s, t, n) + n;
+        if (hasNormals)
+        {
+          *s++ = '/';
+          s = (char*)memcpy(s, t, n) + n;
+        }
+      }
+    }
+    *s++ = '\n';
+    file.commit(s);
+  }
+  return file.close();
+}
+
+bool
+MeshWriter::writePLY(const TriangleMesh& mesh, const char* filename)
+{
+  internal::MeshOutputFile file{filename};
+
+  if (!file.isOpen())
+    return false;
+
+  const auto& data = mesh.data();
+  const auto nv = data.numberOfVertices;
+  const auto nt = data.numberOfTriangles;
+  const auto hasNormals = data.vertexNormals != nullptr;
+  const auto hasUV = data.uv != nullptr;
+  char header[512];
+
+  snprintf(header, sizeof(header),
+    "ply\n"
+    "format %s 1.0\n"
+    "comment cg mesh\n"
+    "element vertex %d\n"
+    "property float x\n"
+    "property float y\n"
+    "property float z\n"
+    "%s%s"
+    "element face %d\n"
+    "property list uchar int vertex_indices\n"
+    "end_header\n",
+    internal::isHostLittleEndian() ? "binary_little_endian" :
+    "binary_big_endian",
+    nv,
+    hasNormals ?
+      "property float nx\nproperty float ny\nproperty float nz\n" : "",
+    hasUV ? "property float u\nproperty float v\n" : "",
+    nt);
+  file.write(header);
+  if (!hasNormals && !hasUV)
+    file.write(data.vertices, sizeof(vec3f) * nv);
+  else
+  {
+    // Interleave the vertex attributes
+    const auto size = sizeof(vec3f) * (1 + hasNormals)
+      + sizeof(vec2f) * hasUV;
+
+    for (int i = 0; i < nv; ++i)
+    {
+      auto s = file.reserve(size);
+
+      s = (char*)memcpy(s, &data.vertices[i], sizeof(vec3f)) + sizeof(vec3f);
+      if (hasNormals)
+        s = (char*)memcpy(s, &data.vertexNormals[i], sizeof(vec3f))
+          + sizeof(vec3f);
+      if (hasUV)
+        s = (char*)memcpy(s, &data.uv[i], sizeof(vec2f)) + sizeof(vec2f);
+      file.commit(s);
+    }
+  }
+
+  constexpr size_t faceSize = 1 + sizeof(TriangleMesh::Triangle);
+
+  for (int i = 0; i < nt; ++i)
+  {
+    auto s = file.reserve(faceSize);
+
+    *s = 3;
+    memcpy(s + 1, data.triangles[i].v, faceSize - 1);
+    file.commit(s + faceSize);
+  }
+  return file.close();
+}
+
+bool
+MeshWriter::write(const TriangleMesh& mesh, const char* filename)
+{
+  if (internal::hasExtension(filename, ".ply"))
+    return writePLY(mesh, filename);
+  if (internal::hasExtension(filename, ".obj"))
+    return writeOBJ(mesh, filename);
+  return false;
+}
+
+} // end namespace cg
@@ -0,0 +1,332 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: Meshlets.cpp
+// ========
+// Source file for triangle mesh meshlets.
+//
+// Last revision: 18/10/2026
+
+#include "geometry/Meshlets.h"
+#include "geometry/TriangleMesh.h"
+#include "utils/MeshOptimizer.h"
+
+namespace cg
+{ // begin namespace cg
+
+namespace internal
+{ // begin namespace internal
+
+// Computes the bounding sphere and normal cone of meshlet m, whose
+// triangles are t and vertex indices are v
+void
+setMeshletBounds(Meshlets::Meshlet& m,
+  const vec3f* p,
+  const TriangleMesh::Triangle* t,
+  const int* v)
+{
+  Bounds3f bounds;
+
+  for (int i = 0; i < m.vertexCount; ++i)
+    bounds.inflate(p[v[i]]);
+  m.center = bounds.center();
+  m.radius = 0;
+  for (int i = 0; i < m.vertexCount; ++i)
+    m.radius = std::max(m.radius, (p[v[i]] - m.center).squaredNorm());
+  m.radius = sqrt(m.radius);
+
+  vec3f axis{0, 0, 0};
+
+  for (int i = 0; i < m.triangleCount; ++i)
+    axis += triangle::normal(p, t[i].v);
+  m.coneAxis = axis.versor();
+
+  auto minDot = 1.0f;
+
+  for (int i = 0; i < m.triangleCount; ++i)
+    minDot = std::min(minDot, triangle::normal(p, t[i].v).dot(m.coneAxis));
+  // Cones wider than about 84 degrees are not worth testing
+  m.coneCutoff = minDot <= 0.1f ? 1 : sqrt(1 - minDot * minDot);
+}
+
+// Appends to visible the indices of the meshlets intersecting the view
+// volume of clip and, if eye is not null, not entirely back facing it
+void
+cullMeshlets(const std::vector<Meshlets::Meshlet>& meshlets,
+  const mat4f& clip,
+  const vec4f* eye,
+  std::vector<int>& visible)
+{
+  // Planes of the view volume, pointing inwards (Gribb and Hartmann)
+  vec4f planes[6];
+
+  for (int i = 0; i < 3; ++i)
+  {
+    const vec4f r{clip[0][i], clip[1][i], clip[2][i], clip[3][i]};
+    const vec4f w{clip[0][3], clip[1][3], clip[2][3], clip[3][3]};
+
+    planes[2 * i] = w + r;
+    planes[2 * i + 1] = w - r;
+  }
+  for (auto& plane : planes)
+    plane *= math::inverse(vec3f{plane}.length());
+  for (int i = 0, n = int(meshlets.size()); i < n; ++i)
+  {
+    const auto& m = meshlets[i];
+    const vec4f c{m.center, 1};
+    auto inside = true;
+
+    for (const auto& plane : planes)
+      if (plane.dot(c) < -m.radius)
+      {
+        inside = false;
+        break;
+      }
+    if (!inside)
+      continue;
+    if (eye != nullptr)
+    {
+      // The meshlet is back facing if the eye is inside the cone with
+      // the opposite axis and the complementary angle of the normal
+      // cone, enlarged to contain the bounding sphere. With an eye at
+      // infinity (w = 0), d is the view direction, the same for every
+      // point of the meshlet
+      const auto d = m.center * eye->w - vec3f{*eye};
+
+      if (d.dot(m.coneAxis) >= m.coneCutoff * d.length() + m.radius * eye->w)
+        continue;
+    }
+    visible.push_back(i);
+  }
+}
+
+} // end namespace internal
+
+
+/////////////////////////////////////////////////////////////////////
+//
+// Meshlets implementation
+// ========
+bool
+Meshlets::Meshlet::intersects(const Ray& ray) const
+{
+  const auto c = center - ray.origin;
+  const auto d = c.dot(ray.direction);
+  const auto h = radius * radius - (c.squaredNorm() - d * d);
+
+  if (h < 0)
+    return false;
+
+  const auto s = sqrt(h);
+
+  return d + s >= ray.tMin && d - s <= ray.tMax;
+}
+
+Meshlets*
+Meshlets::build(TriangleMesh& mesh)
+{
+  const auto& adjacency = mesh.adjacency();
+  auto& data = mesh.editData();
+  const auto nt = data.numberOfTriangles;
+  const auto p = data.vertices;
+  const auto t = data.triangles;
+  auto meshlets = new Meshlets;
+  // Triangles in meshlet order
+  std::vector<TriangleMesh::Triangle> triangles;
+  std::vector<bool> used(nt);
+  // Local index of each vertex in the current meshlet, or -1
+  std::vector<int> local(data.numberOfVertices, -1);
+  // Triangles sharing a vertex with the current meshlet, and the last
+  // meshlet which added each triangle to its candidates
+  std::vector<int> candidates;
+  std::vector<int> marks(nt, -1);
+  Meshlet m{};
+  vec3f sum{0, 0, 0};
+  int cursor{0};
+
+  triangles.reserve(nt);
+
+  auto center = [&](int i)
+  {
+    return triangle::center(p, t[i].v);
+  };
+  auto newVertices = [&](int i)
+  {
+    const auto& v = t[i].v;
+    return (local[v[0]] < 0) + (local[v[1]] < 0 && v[1] != v[0])
+      + (local[v[2]] < 0 && v[2] != v[0] && v[2] != v[1]);
+  };
+  auto finish = [&]()
+  {
+    auto v = meshlets->_vertices.data() + m.firstVertex;
+    auto mt = triangles.data() + m.firstTriangle;
+
+    // Reorder the triangles of the meshlet for the vertex cache, in
+    // local vertex indices so that the cost depends on the meshlet only
+    for (int i = 0; i < m.triangleCount; ++i)
+      for (auto& k : mt[i].v)
+        k = local[k];
+
+    TriangleMesh::Data d{};
+
+    d.numberOfVertices = m.vertexCount;
+    d.numberOfTriangles = m.triangleCount;
+    d.triangles = mt;
+    MeshOptimizer::optimizeVertexCache(d);
+    for (int i = 0; i < m.triangleCount; ++i)
+      for (auto& k : mt[i].v)
+        k = v[k];
+    internal::setMeshletBounds(m, p, mt, v);
+    for (int i = 0; i < m.vertexCount; ++i)
+      local[v[i]] = -1;
+    meshlets->_meshlets.push_back(m);
+    m.firstTriangle += m.triangleCount;
+    m.firstVertex += m.vertexCount;
+    m.triangleCount = m.vertexCount = 0;
+    sum = vec3f{0, 0, 0};
+  };
+
+  for (;;)
+  {
+    // The best candidate adds the fewest vertices and, among those, is
+    // the nearest to the centroid of the vertices of the meshlet
+    auto best = -1;
+    auto bestCount = 4;
+    auto bestDistance = math::Limits<float>::inf();
+    auto nearest = -1;
+    auto nearestDistance = math::Limits<float>::inf();
+    const auto c = sum * math::inverse(float(std::max(m.vertexCount, 1)));
+    size_t n{0};
+
+    for (auto i : candidates)
+    {
+      if (used[i])
+        continue;
+      candidates[n++] = i;
+
+      const auto d = (center(i) - c).squaredNorm();
+
+      if (d < nearestDistance)
+      {
+        nearest = i;
+        nearestDistance = d;
+      }
+
+      const auto count = newVertices(i);
+
+      if (m.vertexCount + count > maxVertices)
+        continue;
+      if (count < bestCount || (count == bestCount && d < bestDistance))
+      {
+        best = i;
+        bestCount = count;
+        bestDistance = d;
+      }
+    }
+    candidates.resize(n);
+    if (best < 0 || m.triangleCount == maxTriangles)
+    {
+      // The meshlet is full or has no adjacent triangles left; the next
+      // one starts at the nearest adjacent triangle, if any, or at the
+      // first triangle not used
+      if (m.triangleCount > 0)
+        finish();
+      candidates.clear();
+      best = nearest;
+      while (best < 0 && cursor < nt)
+        if (!used[cursor++])
+          best = cursor - 1;
+      if (best < 0)
+        break;
+    }
+    used[best] = true;
+    triangles.push_back(t[best]);
+    ++m.triangleCount;
+    for (auto v : t[best].v)
+    {
+      if (local[v] >= 0)
+        continue;
+      local[v] = m.vertexCount++;
+      meshlets->_vertices.push_back(v);
+      sum += p[v];
+      for (auto k : adjacency.vertexCorners(v))
+        if (const auto i = k / 3; !used[i] && marks[i] != m.firstTriangle)
+        {
+          marks[i] = m.firstTriangle;
+          candidates.push_back(i);
+        }
+    }
+  }
+  std::copy(triangles.begin(), triangles.end(), t);
+  mesh.dataChanged(true, false);
+  mesh.meshlets = meshlets;
+  return meshlets;
+}
+
+bool
+Meshlets::transform(const mat4f& trs)
+{
+  const vec3f c0{trs[0]};
+  const vec3f c1{trs[1]};
+  const vec3f c2{trs[2]};
+  const auto s = c0.squaredNorm();
+  const auto eps = s * 1e-4f;
+
+  if (fabs(c1.squaredNorm() - s) > eps
+    || fabs(c2.squaredNorm() - s) > eps
+    || fabs(c0.dot(c1)) > eps
+    || fabs(c0.dot(c2)) > eps
+    || fabs(c1.dot(c2)) > eps
+    || s == 0)
+    return false;
+
+  // A reflection flips the winding, hence the triangle normals
+  const auto scale = sqrt(s);
+  const auto k = math::inverse(c0.cross(c1).dot(c2) < 0 ? -scale : scale);
+
+  for (auto& m : _meshlets)
+  {
+    m.center = trs.transform3x4(m.center);
+    m.radius *= scale;
+    m.coneAxis = trs.transformVector(m.coneAxis) * k;
+  }
+  return true;
+}
+
+void
+Meshlets::cull(const mat4f& clip, std::vector<int>& visible) const
+{
+  internal::cullMeshlets(_meshlets, clip, nullptr, visible);
+}
+
+void
+Meshlets::cull(const mat4f& clip,
+  const vec4f& eye,
+  std::vector<int>& visible) const
+{
+  internal::cullMeshlets(_meshlets, clip, &eye, visible);
+}
+
+} // end namespace cg
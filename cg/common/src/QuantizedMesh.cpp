@@ -0,0 +1,320 @@
+//[]---------------------------------------------------------------[]
+//|                                                                 |
+//| Copyright (C) 2019 Orthrus Group.                               |
+//|                                                                 |
+//| This software is provided 'as-is', without any express or       |
+//| implied warranty. In no event will the authors be held liable   |
+//| for any damages arising from the use of this software.          |
+//|                                                                 |
+//| Permission is granted to anyone to use this software for any    |
+//| purpose, including commercial applications, and to alter it and |
+//| redistribute it freely, subject to the following restrictions:  |
+//|                                                                 |
+//| 1. The origin of this software must not be misrepresented; you  |
+//| must not claim that you wrote the original software. If you use |
+//| this software in a product, an acknowledgment in the product    |
+//| documentation would be appreciated but is not required.         |
+//|                                                                 |
+//| 2. Altered source versions must be plainly marked as such, and  |
+//| must not be misrepresented as being the original software.      |
+//|                                                                 |
+//| 3. This notice may not be removed or altered from any source    |
+//| distribution.                                                   |
+//|                                                                 |
+//[]---------------------------------------------------------------[]
+//
+// OVERVIEW: QuantizedMesh.cpp
+// ========
+// Source file for quantized triangle mesh.
+//
+// Last revision: 18/10/2026
+
+#include "geometry/QuantizedMesh.h"
+#include <cstring>
+
+namespace cg
+{ // begin namespace cg
+
+namespace internal
+{ // begin namespace internal
+
+inline uint32_t
+floatBits(float x)
+{
+  uint32_t b;
+
+  memcpy(&b, &x, sizeof b);
+  return b;
+}
+
+inline float
+bitsFloat(uint32_t b)
+{
+  float x;
+
+  memcpy(&x, &b, sizeof x);
+  return x;
+}
+
+// Returns x in [0,1] quantized to 16 bits
+inline uint16_t
+unorm16(float x)
+{
+  return uint16_t(math::clamp(x, 0.0f, 1.0f) * 65535 + 0.5f);
+}
+
+// Returns x in [-1,1] quantized to a signed integer of the given bits
+inline int
+snorm(float x, int bits)
+{
+  const auto s = float((1 << (bits - 1)) - 1);
+
+  return int(std::round(math::clamp(x, -1.0f, 1.0f) * s));
+}
+
+} // end namespace internal
+
+
+/////////////////////////////////////////////////////////////////////
+//
+// QuantizedMesh implementation
+// =============
+uint16_t
+QuantizedMesh::toHalf(float x)
+{
+  const auto b = internal::floatBits(x);
+  const auto sign = uint16_t((b >> 16) & 0x8000);
+  const auto e = b & 0x7fffffff;
+
+  // NaN, infinity or overflow
+  if (e >= 0x47800000)
+    return sign | (e > 0x7f800000 ? 0x7e00 : 0x7c00);
+  // Underflow: flush to zero
+  if (e < 0x38800000)
+    return sign;
+  // Rebias the exponent (from 127 to 15) and round to nearest
+  return sign | uint16_t((e - 0x38000000 + 0x1000) >> 13);
+}
+
+float
+QuantizedMesh::fromHalf(uint16_t h)
+{
+  const uint32_t sign = uint32_t(h & 0x8000) << 16;
+  const uint32_t e = (h >> 10) & 0x1f;
+  const uint32_t m = h & 0x3ff;
+
+  if (e == 0)
+  {
+    const auto x = std::ldexp(float(m), -24);
+    return sign != 0 ? -x : x;
+  }
+  if (e == 0x1f)
+    return internal::bitsFloat(sign | 0x7f800000 | (m << 13));
+  return internal::bitsFloat(sign | ((e + 112) << 23) | (m << 13));
+}
+
+vec2f
+QuantizedMesh::octEncode(const vec3f& n)
+{
+  const auto d = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+
+  if (math::isZero(d))
+    return {0, 0};
+
+  auto x = n.x / d;
+  auto y = n.y / d;
+
+  if (n.z < 0)
+  {
+    const auto tx = x;
+
+    x = (1 - std::abs(y)) * (tx >= 0 ? 1 : -1);
+    y = (1 - std::abs(tx)) * (y >= 0 ? 1 : -1);
+  }
+  return {x, y};
+}
+
+vec3f
+QuantizedMesh::octDecode(const vec2f& e)
+{
+  vec3f n{e.x, e.y, 1 - std::abs(e.x) - std::abs(e.y)};
+  const auto t = std::max(-n.z, 0.0f);
+
+  n.x += n.x >= 0 ? -t : t;
+  n.y += n.y >= 0 ? -t : t;
+  return n.versor();
+}
+
+QuantizedMesh::QuantizedMesh(const TriangleMesh& mesh, int normalBits):
+  _normalBits{normalBits <= 8 ? 8 : 16}
+{
+  const auto& m = mesh.data();
+  const auto nv = _numberOfVertices = m.numberOfVertices;
+  const auto nt = _numberOfTriangles = m.numberOfTriangles;
+
+  _bounds = mesh.bounds();
+
+  const auto& p1 = _bounds.min();
+  const auto s = _bounds.size();
+  const vec3f is{
+    math::isZero(s.x) ? 0 : 1 / s.x,
+    math::isZero(s.y) ? 0 : 1 / s.y,
+    math::isZero(s.z) ? 0 : 1 / s.z};
+
+  _positions.resize(4 * size_t(nv));
+  for (int i = 0; i < nv; ++i)
+  {
+    const auto p = (mesh.vertex(i) - p1) * is;
+    auto q = _positions.data() + 4 * i;
+
+    q[0] = internal::unorm16(p.x);
+    q[1] = internal::unorm16(p.y);
+    q[2] = internal::unorm16(p.z);
+    q[3] = 0;
+  }
+  if (m.vertexNormals != nullptr)
+  {
+    _normals.resize(size_t(nv) * _normalBits / 4);
+    for (int i = 0; i < nv; ++i)
+    {
+      const auto e = octEncode(m.vertexNormals[i]);
+      const auto x = internal::snorm(e.x, _normalBits);
+      const auto y = internal::snorm(e.y, _normalBits);
+
+      if (_normalBits == 8)
+      {
+        _normals[2 * i] = int8_t(x);
+        _normals[2 * i + 1] = int8_t(y);
+      }
+      else
+      {
+        const int16_t q[2]{int16_t(x), int16_t(y)};
+        memcpy(_normals.data() + 4 * i, q, sizeof q);
+      }
+    }
+  }
+  if (m.uv != nullptr)
+  {
+    _uv.resize(2 * size_t(nv));
+    for (int i = 0; i < nv; ++i)
+    {
+      _uv[2 * i] = toHalf(m.uv[i].x);
+      _uv[2 * i + 1] = toHalf(m.uv[i].y);
+    }
+  }
+  _indexSize = nv <= 65536 ? 2 : 4;
+
+  const auto ni = 3 * size_t(nt);
+
+  _indices.resize(ni * _indexSize);
+  if (_indexSize == 4)
+    memcpy(_indices.data(), m.triangles, _indices.size());
+  else
+  {
+    auto v = &m.triangles[0].v[0];
+    auto q = (uint16_t*)_indices.data();
+
+    for (size_t i = 0; i < ni; ++i)
+      q[i] = uint16_t(v[i]);
+  }
+}
+
+mat4f
+QuantizedMesh::positionMatrix() const
+{
+  const auto s = _bounds.size();
+
+  return mat4f{vec4f{s.x, 0, 0, 0},
+    vec4f{0, s.y, 0, 0},
+    vec4f{0, 0, s.z, 0},
+    vec4f{_bounds.min(), 1}};
+}
+
+size_t
+QuantizedMesh::size() const
+{
+  return sizeof(uint16_t) * (_positions.size() + _uv.size()) +
+    _normals.size() + _indices.size();
+}
+
+vec3f
+QuantizedMesh::position(int i) const
+{
+  const auto q = _positions.data() + 4 * i;
+  const vec3f p{q[0] / 65535.0f, q[1] / 65535.0f, q[2] / 65535.0f};
+
+  return _bounds.min() + p * _bounds.size();
+}
+
+vec3f
+QuantizedMesh::normal(int i) const
+{
+  const auto s = float((1 << (_normalBits - 1)) - 1);
+  int x, y;
+
+  if (_normalBits == 8)
+  {
+    x = _normals[2 * i];
+    y = _normals[2 * i + 1];
+  }
+  else
+  {
+    int16_t q[2];
+
+    memcpy(q, _normals.data() + 4 * i, sizeof q);
+    x = q[0];
+    y = q[1];
+  }
+  return octDecode({std::max(x / s, -1.0f), std::max(y / s, -1.0f)});
+}
+
+vec2f
+QuantizedMesh::uv(int i) const
+{
+  return {fromHalf(_uv[2 * i]), fromHalf(_uv[2 * i + 1])};
+}
+
+TriangleMesh::Triangle
+QuantizedMesh::triangle(int i) const
+{
+  TriangleMesh::Triangle t;
+
+  if (_indexSize == 4)
+    memcpy(t.v, _indices.data() + 12 * size_t(i), sizeof t.v);
+  else
+  {
+    auto q = (const uint16_t*)_indices.data() + 3 * size_t(i);
+    t.setVertices(q[0], q[1], q[2]);
+  }
+  return t;
+}
+
+TriangleMesh*
+QuantizedMesh::decode() const
+{
+  const auto nv = _numberOfVertices;
+  const auto nt = _numberOfTriangles;
+  TriangleMesh::Data data{};
+
+  data.numberOfVertices = nv;
+  data.vertices = new vec3f[nv];
+  if (hasNormals())
+    data.vertexNormals = new vec3f[nv];
+  if (hasUV())
+    data.uv = new vec2f[nv];
+  data.numberOfTriangles = nt;
+  data.triangles = new TriangleMesh::Triangle[nt];
+  for (int i = 0; i < nv; ++i)
+  {
+    data.vertices[i] = position(i);
+    if (data.vertexNormals != nullptr)
+      data.vertexNormals[i] = normal(i);
+    if (data.uv != nullptr)
+      data.uv[i] = uv(i);
+  }
+  for (int i = 0; i < nt; ++i)
+    data.triangles[i] = triangle(i);
+  return new TriangleMesh{std::move(data)};
+}
+
+} // end namespace cg
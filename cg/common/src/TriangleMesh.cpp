@@ -30,18 +30,321 @@
 // Author: Paulo Pagliosa
 // Last revision: 02/06/2019
 
+#include "core/Parallel.h"
 #include "geometry/MeshSweeper.h"
+#include "math/BatchTransform.h"
+#include "math/SIMD.h"
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 namespace cg
 { // begin namespace cg
 
+namespace internal
+{ // begin namespace internal
+
+// Strided view of vertex positions, AoS (stride 3) or SoA (stride 1)
+struct PointView
+{
+  const float* x;
+  const float* y;
+  const float* z;
+  int stride;
+
+  vec3f operator [](int i) const
+  {
+    i *= stride;
+    return {x[i], y[i], z[i]};
+  }
+
+}; // PointView
+
+// Angle at p of the triangle (p, q, r)
+inline float
+cornerAngle(const vec3f& p, const vec3f& q, const vec3f& r)
+{
+  const auto u = q - p;
+  const auto v = r - p;
+  const auto d = u.length() * v.length();
+
+  if (math::isZero(d))
+    return 0;
+  return acos(math::clamp(u.dot(v) / d, -1.0f, 1.0f));
+}
+
+// Minimum number of elements processed by a thread
+const int minNormalRange{16 * 1024};
+const int minBoundsRange{64 * 1024};
+
+#ifdef DS_USE_SSE
+
+// Bounds of the n points of v
+inline Bounds3f
+aosBounds(const vec3f* v, int n)
+{
+  Bounds3f bounds;
+  int i = 0;
+
+  if (n >= 4)
+  {
+    // Each register holds coordinates of 4 points in the order
+    // x y z x, y z x y and z x y z
+    auto p = &v->x;
+    __m128 lo[3], hi[3];
+
+    for (int k = 0; k < 3; ++k)
+      lo[k] = hi[k] = _mm_loadu_ps(p + 4 * k);
+    for (i = 4; i + 4 <= n; i += 4)
+    {
+      p = &v[i].x;
+      for (int k = 0; k < 3; ++k)
+      {
+        const auto c = _mm_loadu_ps(p + 4 * k);
+
+        lo[k] = _mm_min_ps(lo[k], c);
+        hi[k] = _mm_max_ps(hi[k], c);
+      }
+    }
+
+    alignas(16) float m[2][12];
+
+    for (int k = 0; k < 3; ++k)
+    {
+      _mm_store_ps(m[0] + 4 * k, lo[k]);
+      _mm_store_ps(m[1] + 4 * k, hi[k]);
+    }
+    for (int k = 0; k < 12; k += 3)
+    {
+      bounds.inflate(m[0][k], m[0][k + 1], m[0][k + 2]);
+      bounds.inflate(m[1][k], m[1][k + 1], m[1][k + 2]);
+    }
+  }
+  for (; i < n; ++i)
+    bounds.inflate(v[i]);
+  return bounds;
+}
+
+// Bounds of the points of the SoA arrays x, y and z, aligned to 16
+// bytes, whose size n is a multiple of 4
+inline Bounds3f
+soaBounds(const float* x, const float* y, const float* z, int n)
+{
+  if (n == 0)
+    return Bounds3f{};
+
+  auto xMin = _mm_load_ps(x), xMax = xMin;
+  auto yMin = _mm_load_ps(y), yMax = yMin;
+  auto zMin = _mm_load_ps(z), zMax = zMin;
+
+  for (int i = 4; i < n; i += 4)
+  {
+    const auto px = _mm_load_ps(x + i);
+    const auto py = _mm_load_ps(y + i);
+    const auto pz = _mm_load_ps(z + i);
+
+    xMin = _mm_min_ps(xMin, px);
+    xMax = _mm_max_ps(xMax, px);
+    yMin = _mm_min_ps(yMin, py);
+    yMax = _mm_max_ps(yMax, py);
+    zMin = _mm_min_ps(zMin, pz);
+    zMax = _mm_max_ps(zMax, pz);
+  }
+
+  alignas(16) float m[6][4];
+
+  _mm_store_ps(m[0], xMin);
+  _mm_store_ps(m[1], yMin);
+  _mm_store_ps(m[2], zMin);
+  _mm_store_ps(m[3], xMax);
+  _mm_store_ps(m[4], yMax);
+  _mm_store_ps(m[5], zMax);
+
+  Bounds3f bounds;
+
+  for (int i = 0; i < 4; ++i)
+  {
+    bounds.inflate(m[0][i], m[1][i], m[2][i]);
+    bounds.inflate(m[3][i], m[4][i], m[5][i]);
+  }
+  return bounds;
+}
+
+// Computes the normals of the nt triangles of t, whose vertices are
+// in p: unit normals or, if area is true, normals whose lengths are
+// twice the triangle areas
+template <int stride>
+void
+faceNormals(const PointView& p,
+  const TriangleMesh::Triangle* t,
+  int nt,
+  bool area,
+  vec3f* normals)
+{
+  const auto eps = _mm_set1_ps(math::Limits<float>::eps());
+  const auto one = _mm_set1_ps(1);
+  TriangleMesh::Triangle last[4];
+
+  for (int i = 0; i < nt; i += 4)
+  {
+    auto f = t + i;
+
+    // The last group repeats the last triangle in its unused lanes
+    if (i + 4 > nt)
+    {
+      for (int k = 0; k < 4; ++k)
+        last[k] = t[std::min(i + k, nt - 1)];
+      f = last;
+    }
+
+    auto gather = [f](const float* a, int k)
+    {
+      return _mm_setr_ps(a[stride * f[0].v[k]],
+        a[stride * f[1].v[k]],
+        a[stride * f[2].v[k]],
+        a[stride * f[3].v[k]]);
+    };
+    const auto x0 = gather(p.x, 0), y0 = gather(p.y, 0), z0 = gather(p.z, 0);
+    const auto ux = _mm_sub_ps(gather(p.x, 1), x0);
+    const auto uy = _mm_sub_ps(gather(p.y, 1), y0);
+    const auto uz = _mm_sub_ps(gather(p.z, 1), z0);
+    const auto vx = _mm_sub_ps(gather(p.x, 2), x0);
+    const auto vy = _mm_sub_ps(gather(p.y, 2), y0);
+    const auto vz = _mm_sub_ps(gather(p.z, 2), z0);
+    // Same order of operations as triangle::normal()
+    auto nx = _mm_sub_ps(_mm_mul_ps(uy, vz), _mm_mul_ps(uz, vy));
+    auto ny = _mm_sub_ps(_mm_mul_ps(uz, vx), _mm_mul_ps(ux, vz));
+    auto nz = _mm_sub_ps(_mm_mul_ps(ux, vy), _mm_mul_ps(uy, vx));
+
+    if (!area)
+    {
+      const auto len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx),
+        _mm_mul_ps(ny, ny)),
+        _mm_mul_ps(nz, nz)));
+      const auto mask = _mm_cmpnle_ps(len, eps);
+      const auto s = _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(one, len)),
+        _mm_andnot_ps(mask, one));
+
+      nx = _mm_mul_ps(nx, s);
+      ny = _mm_mul_ps(ny, s);
+      nz = _mm_mul_ps(nz, s);
+    }
+
+    alignas(16) float n[3][4];
+
+    _mm_store_ps(n[0], nx);
+    _mm_store_ps(n[1], ny);
+    _mm_store_ps(n[2], nz);
+    for (int k = 0, e = std::min(4, nt - i); k < e; ++k)
+      normals[i + k].set(n[0][k], n[1][k], n[2][k]);
+  }
+}
+
+inline void
+faceNormals(const PointView& p,
+  const TriangleMesh::Triangle* t,
+  int nt,
+  bool area,
+  vec3f* normals)
+{
+  if (p.stride == 1)
+    faceNormals<1>(p, t, nt, area, normals);
+  else
+    faceNormals<3>(p, t, nt, area, normals);
+}
+
+// Normalizes the n vectors of v, as vec3f::normalize() does
+inline void
+normalizeVectors(vec3f* v, int n)
+{
+  const auto eps = _mm_set1_ps(math::Limits<float>::eps());
+  const auto one = _mm_set1_ps(1);
+  int i = 0;
+
+  for (; i + 4 <= n; i += 4)
+  {
+    auto p = &v[i].x;
+    const auto x = _mm_setr_ps(p[0], p[3], p[6], p[9]);
+    const auto y = _mm_setr_ps(p[1], p[4], p[7], p[10]);
+    const auto z = _mm_setr_ps(p[2], p[5], p[8], p[11]);
+    const auto len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x),
+      _mm_mul_ps(y, y)),
+      _mm_mul_ps(z, z)));
+    const auto mask = _mm_cmpnle_ps(len, eps);
+    const auto s = _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(one, len)),
+      _mm_andnot_ps(mask, one));
+
+    // The 12 floats of the 4 vectors times (s0 s0 s0 s1 s1 s1 ...)
+    _mm_storeu_ps(p, _mm_mul_ps(_mm_loadu_ps(p),
+      _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 0, 0, 0))));
+    _mm_storeu_ps(p + 4, _mm_mul_ps(_mm_loadu_ps(p + 4),
+      _mm_shuffle_ps(s, s, _MM_SHUFFLE(2, 2, 1, 1))));
+    _mm_storeu_ps(p + 8, _mm_mul_ps(_mm_loadu_ps(p + 8),
+      _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 2))));
+  }
+  for (; i < n; ++i)
+    v[i].normalize();
+}
+
+#else // DS_USE_SSE
+
+inline Bounds3f
+aosBounds(const vec3f* v, int n)
+{
+  Bounds3f bounds;
+
+  for (int i = 0; i < n; ++i)
+    bounds.inflate(v[i]);
+  return bounds;
+}
+
+inline Bounds3f
+soaBounds(const float* x, const float* y, const float* z, int n)
+{
+  Bounds3f bounds;
+
+  for (int i = 0; i < n; ++i)
+    bounds.inflate(x[i], y[i], z[i]);
+  return bounds;
+}
+
+inline void
+faceNormals(const PointView& p,
+  const TriangleMesh::Triangle* t,
+  int nt,
+  bool area,
+  vec3f* normals)
+{
+  for (int i = 0; i < nt; ++i, ++t)
+  {
+    const auto p0 = p[t->v[0]];
+    const auto p1 = p[t->v[1]];
+    const auto p2 = p[t->v[2]];
+
+    normals[i] = area ?
+      (p1 - p0).cross(p2 - p0) :
+      triangle::normal(p0, p1, p2);
+  }
+}
+
+inline void
+normalizeVectors(vec3f* v, int n)
+{
+  for (int i = 0; i < n; ++i)
+    v[i].normalize();
+}
+
+#endif // DS_USE_SSE
+
+} // end namespace internal
+
 
 /////////////////////////////////////////////////////////////////////
 //
 // TriangleMesh implementation
 // ============
-static uint32_t nextMeshId;
+// Meshes are created by the worker threads of the asset loader as well
+static std::atomic<uint32_t> nextMeshId;
 
 TriangleMesh::TriangleMesh(Data&& data):
   id{++nextMeshId},
@@ -50,64 +353,426 @@ TriangleMesh::TriangleMesh(Data&& data):
   memset(&data, 0, sizeof(Data));
 }
 
+TriangleMesh::TriangleMesh(const Data& data,
+  SharedObject* storage,
+  const Bounds3f* bounds):
+  id{++nextMeshId},
+  _data{data},
+  _storage{storage}
+{
+  if (bounds != nullptr)
+  {
+    _bounds = *bounds;
+    _hasBounds = true;
+  }
+}
+
 TriangleMesh::~TriangleMesh()
 {
+  simd::deallocate(_vertexArrays.x);
+  if (_storage != nullptr)
+    return;
   delete []_data.vertices;
   delete []_data.vertexNormals;
   delete []_data.uv;
   delete []_data.triangles;
 }
 
+void
+TriangleMesh::setVertexLayout(VertexLayout layout)
+{
+  if (layout == vertexLayout())
+    return;
+  if (layout == VertexLayout::AoS)
+  {
+    data();
+    simd::deallocate(_vertexArrays.x);
+    _vertexArrays = {};
+    return;
+  }
+
+  const auto nv = _data.numberOfVertices;
+
+  if (nv == 0)
+    return;
+
+  const auto n = simd::floatsPerLine;
+  const auto stride = (nv + n - 1) / n * n;
+  auto x = simd::allocate<float>(3 * size_t(stride));
+
+  _vertexArrays = {x, x + stride, x + 2 * stride, stride};
+  loadVertexArrays();
+}
+
+void
+TriangleMesh::loadVertexArrays()
+{
+  const auto nv = _data.numberOfVertices;
+
+  for (int i = 0; i < _vertexArrays.stride; ++i)
+  {
+    const auto& p = _data.vertices[i < nv ? i : nv - 1];
+
+    _vertexArrays.x[i] = p.x;
+    _vertexArrays.y[i] = p.y;
+    _vertexArrays.z[i] = p.z;
+  }
+}
+
+void
+TriangleMesh::interleaveVertices() const
+{
+  for (int i = 0; i < _data.numberOfVertices; ++i)
+    _data.vertices[i] = vertex(i);
+  _verticesChanged = false;
+}
+
+void
+TriangleMesh::dataChanged(bool topologyChanged, bool geometryChanged)
+{
+  _hasBounds = false;
+  meshlets = nullptr;
+  if (topologyChanged)
+    _adjacency = nullptr;
+  if (geometryChanged)
+    lods.clear();
+  // Data::vertices is stale only if the SoA positions changed after the
+  // last call to data() (e.g., by TRS()), and then editData() was not
+  // called, so the SoA positions are the ones to keep
+  if (_verticesChanged)
+    interleaveVertices();
+  else if (_vertexArrays.x != nullptr)
+    loadVertexArrays();
+  userData = nullptr;
+}
+
 Bounds3f
 TriangleMesh::bounds() const
 {
-  Bounds3f bounds;
+  if (_hasBounds)
+    return _bounds;
 
-  for (int i = 0; i < _data.numberOfVertices; i++)
-    bounds.inflate(_data.vertices[i]);
-  return bounds;
+  const auto& a = _vertexArrays;
+  const auto n = a.x != nullptr ? a.stride : _data.numberOfVertices;
+  std::mutex mutex;
+
+  _bounds.setEmpty();
+  // SoA ranges must start at multiples of 4 to keep the arrays aligned
+  parallel::forRange(n / 4, internal::minBoundsRange / 4, [&](int b, int e)
+  {
+    b *= 4;
+    e = e * 4 == n / 4 * 4 ? n : e * 4;
+
+    const auto bounds = a.x != nullptr ?
+      internal::soaBounds(a.x + b, a.y + b, a.z + b, e - b) :
+      internal::aosBounds(_data.vertices + b, e - b);
+    std::lock_guard<std::mutex> lock{mutex};
+
+    _bounds.inflate(bounds);
+  });
+  // Arrays with less than 4 vertices
+  if (n < 4)
+    _bounds = internal::aosBounds(_data.vertices, n);
+  _hasBounds = true;
+  return _bounds;
+}
+
+const MeshAdjacency&
+TriangleMesh::adjacency() const
+{
+  if (_adjacency == nullptr)
+    _adjacency = new MeshAdjacency{_data.numberOfVertices,
+      _data.numberOfTriangles,
+      &_data.triangles->v[0]};
+  return *_adjacency;
 }
 
 void
-TriangleMesh::computeNormals()
+TriangleMesh::computeNormals(NormalWeighting weighting, int numberOfThreads)
 {
-  auto nv = _data.numberOfVertices;
+  const auto nv = _data.numberOfVertices;
+  const auto nt = _data.numberOfTriangles;
 
   if (_data.vertexNormals == nullptr)
     _data.vertexNormals = new vec3f[nv];
+  if (numberOfThreads <= 0)
+    numberOfThreads = parallel::defaultNumberOfThreads();
 
-  auto t = _data.triangles;
+  const auto& a = _vertexArrays;
+  const auto v = _data.vertices;
+  const auto p = a.x != nullptr ?
+    internal::PointView{a.x, a.y, a.z, 1} :
+    internal::PointView{&v->x, &v->y, &v->z, 3};
+  const auto t = _data.triangles;
+  const auto angle = weighting == NormalWeighting::Angle;
 
-  memset(_data.vertexNormals, 0, nv * sizeof(vec3f));
-  for (int i = 0; i < _data.numberOfTriangles; ++i, ++t)
+  // Computes the normals (and corner angles) of triangles [b, e)
+  auto faceNormals = [&](int b, int e, vec3f* normals, float* angles)
+  {
+    internal::faceNormals(p,
+      t + b,
+      e - b,
+      weighting == NormalWeighting::Area,
+      normals);
+    if (angle)
+      for (int i = b; i < e; ++i, angles += 3)
+      {
+        const auto p0 = p[t[i].v[0]];
+        const auto p1 = p[t[i].v[1]];
+        const auto p2 = p[t[i].v[2]];
+
+        angles[0] = internal::cornerAngle(p0, p1, p2);
+        angles[1] = internal::cornerAngle(p1, p2, p0);
+        angles[2] = internal::cornerAngle(p2, p0, p1);
+      }
+  };
+  auto n = _data.vertexNormals;
+
+  if (numberOfThreads == 1 || nv < 2 * internal::minNormalRange)
   {
-    auto v0 = t->v[0];
-    auto v1 = t->v[1];
-    auto v2 = t->v[2];
-    auto normal = triangle::normal(_data.vertices, v0, v1, v2);
+    // Scatter the normals of blocks of triangles small enough to stay
+    // in the cache
+    constexpr int blockSize = 256;
+    vec3f normals[blockSize];
+    float angles[3 * blockSize];
+
+    memset(n, 0, nv * sizeof(vec3f));
+    for (int b = 0; b < nt; b += blockSize)
+    {
+      const auto e = std::min(b + blockSize, nt);
+
+      faceNormals(b, e, normals, angles);
+      for (int i = b; i < e; ++i)
+      {
+        const auto& normal = normals[i - b];
+        const auto v = t[i].v;
 
-    _data.vertexNormals[v0] += normal;
-    _data.vertexNormals[v1] += normal;
-    _data.vertexNormals[v2] += normal;
+        if (!angle)
+        {
+          n[v[0]] += normal;
+          n[v[1]] += normal;
+          n[v[2]] += normal;
+        }
+        else
+          for (int k = 0; k < 3; ++k)
+            n[v[k]] += normal * angles[3 * (i - b) + k];
+      }
+    }
+    internal::normalizeVectors(n, nv);
+    return;
   }
-  for (int i = 0; i < nv; ++i)
-    _data.vertexNormals[i].normalize();
+
+  std::unique_ptr<vec3f[]> normals{new vec3f[nt]};
+  std::unique_ptr<float[]> angles{angle ? new float[3 * size_t(nt)] : nullptr};
+
+  parallel::forRange(nt, internal::minNormalRange, [&](int b, int e)
+  {
+    faceNormals(b, e, normals.get() + b, angles.get() + 3 * b);
+  }, numberOfThreads);
+
+  const auto& adjacency = this->adjacency();
+
+  // Gather the normals of the triangles of each vertex, in triangle
+  // order, so that the result is the same as the serial one
+  parallel::forRange(nv, internal::minNormalRange, [&](int b, int e)
+  {
+    for (int i = b; i < e; ++i)
+    {
+      vec3f s{0, 0, 0};
+
+      for (auto c : adjacency.vertexCorners(i))
+        if (!angle)
+          s += normals[c / 3];
+        else
+          s += normals[c / 3] * angles[c];
+      n[i] = s;
+    }
+    internal::normalizeVectors(n + b, e - b);
+  }, numberOfThreads);
 }
 
-void
-TriangleMesh::TRS(const mat4f& trs)
+TriangleMesh*
+TriangleMesh::splitCreases(float creaseAngle,
+  NormalWeighting weighting,
+  int numberOfThreads) const
 {
-  auto nv = _data.numberOfVertices;
+  const auto& data = this->data();
+  const auto nv = data.numberOfVertices;
+  const auto nt = data.numberOfTriangles;
+  const auto& adjacency = this->adjacency();
+  const auto v = data.vertices;
+  const internal::PointView p{&v->x, &v->y, &v->z, 3};
+  const auto t = data.triangles;
+  const auto minRange = internal::minNormalRange;
+  std::unique_ptr<vec3f[]> normals{new vec3f[nt]};
 
-  for (int i = 0; i < nv; ++i)
-    _data.vertices[i] = trs.transform3x4(_data.vertices[i]);
-  if (_data.vertexNormals == nullptr)
-    return;
+  parallel::forRange(nt, minRange, [&](int b, int e)
+  {
+    internal::faceNormals(p,
+      t + b,
+      e - b,
+      weighting == NormalWeighting::Area,
+      normals.get() + b);
+  }, numberOfThreads);
+
+  const auto minCos = cos(math::toRadians(creaseAngle));
+  // Smooth group of each corner, and offset of the first copy of each
+  // vertex in the new mesh
+  std::vector<int> groups(3 * size_t(nt));
+  std::vector<int> offsets(nv + 1);
+
+  // The groups of a vertex with creases are the sets of its corners
+  // connected by smooth edges, found by union-find and numbered in
+  // triangle order. A vertex without creases is never split
+  parallel::forRange(nv, minRange, [&](int b, int e)
+  {
+    std::vector<int> parents;
+    std::vector<int> labels;
+
+    auto find = [&](int i)
+    {
+      while (parents[i] != i)
+        i = parents[i] = parents[parents[i]];
+      return i;
+    };
+
+    for (int i = b; i < e; ++i)
+    {
+      const auto corners = adjacency.vertexCorners(i);
+      const auto n = corners.size();
+
+      auto creased = false;
+
+      parents.resize(n);
+      for (int k = 0; k < n; ++k)
+        parents[k] = k;
+      for (int k = 0; k < n; ++k)
+      {
+        const auto c = corners[k];
+        const auto d = adjacency.twin(c);
+
+        if (d < 0)
+          continue;
 
-  auto r = normalTRS(trs);
+        const auto& n0 = normals[c / 3];
+        const auto& n1 = normals[d / 3];
 
+        if (n0.dot(n1) < minCos * n0.length() * n1.length())
+        {
+          creased = true;
+          continue;
+        }
+
+        // The corner of vertex i in the triangle across the edge of c
+        const auto o = std::lower_bound(corners.begin(),
+          corners.end(),
+          MeshAdjacency::next(d));
+
+        parents[find(k)] = find(int(o - corners.begin()));
+      }
+      labels.assign(n, -1);
+
+      int m{0};
+
+      for (int k = 0; k < n; ++k)
+      {
+        auto& label = labels[creased ? find(k) : 0];
+
+        if (label < 0)
+          label = m++;
+        groups[corners[k]] = label;
+      }
+      offsets[i + 1] = std::max(m, 1);
+    }
+  }, numberOfThreads);
   for (int i = 0; i < nv; ++i)
-    _data.vertexNormals[i] = (r * _data.vertexNormals[i]).versor();
+    offsets[i + 1] += offsets[i];
+
+  Data split{};
+
+  split.numberOfVertices = offsets[nv];
+  split.numberOfTriangles = nt;
+  split.vertices = new vec3f[split.numberOfVertices];
+  split.vertexNormals = new vec3f[split.numberOfVertices];
+  if (data.uv != nullptr)
+    split.uv = new vec2f[split.numberOfVertices];
+  split.triangles = new Triangle[nt];
+  parallel::forRange(nv, minRange, [&](int b, int e)
+  {
+    for (int i = b; i < e; ++i)
+    {
+      const auto s = offsets[i];
+      const auto n = split.vertexNormals + s;
+
+      for (auto j = s; j < offsets[i + 1]; ++j)
+      {
+        split.vertices[j] = v[i];
+        split.vertexNormals[j] = vec3f{0, 0, 0};
+        if (split.uv != nullptr)
+          split.uv[j] = data.uv[i];
+      }
+      for (auto c : adjacency.vertexCorners(i))
+        if (weighting != NormalWeighting::Angle)
+          n[groups[c]] += normals[c / 3];
+        else
+        {
+          const auto a = internal::cornerAngle(v[i],
+            v[adjacency.vertex(MeshAdjacency::next(c))],
+            v[adjacency.vertex(MeshAdjacency::previous(c))]);
+
+          n[groups[c]] += normals[c / 3] * a;
+        }
+    }
+    internal::normalizeVectors(split.vertexNormals + offsets[b],
+      offsets[e] - offsets[b]);
+  }, numberOfThreads);
+  parallel::forRange(nt, minRange, [&](int b, int e)
+  {
+    for (int i = b; i < e; ++i)
+      for (int k = 0; k < 3; ++k)
+      {
+        const auto c = 3 * i + k;
+
+        split.triangles[i].v[k] = offsets[t[i].v[k]] + groups[c];
+      }
+  }, numberOfThreads);
+  return new TriangleMesh{std::move(split)};
+}
+
+void
+TriangleMesh::TRS(const mat4f& trs, int numberOfThreads)
+{
+  const auto nv = _data.numberOfVertices;
+  const auto& a = _vertexArrays;
+
+  _hasBounds = false;
+  if (a.x != nullptr)
+  {
+    transformPoints(trs, a.x, a.y, a.z, a.stride, numberOfThreads);
+    _verticesChanged = true;
+  }
+  else
+    transformPoints(trs, _data.vertices, _data.vertices, nv, numberOfThreads);
+  if (_data.vertexNormals != nullptr)
+    transformVectors(normalTRS(trs),
+      _data.vertexNormals,
+      _data.vertexNormals,
+      nv,
+      true,
+      numberOfThreads);
+  for (auto& lod : lods)
+    lod.mesh->TRS(trs, numberOfThreads);
+  if (meshlets != nullptr && !meshlets->transform(trs))
+    meshlets = nullptr;
+}
+
+TriangleMesh*
+TriangleMesh::lod(float size, float maxError)
+{
+  for (auto i = lods.rbegin(); i != lods.rend(); ++i)
+    if (i->error * size <= maxError)
+      return i->mesh;
+  return this;
 }
 
 static inline void
@@ -130,7 +795,7 @@ TriangleMesh::print(const char* s, FILE* f) const
   for (int i = 0; i < _data.numberOfVertices; ++i)
   {
     fprintf(f, "    %d ", i);
-    printv(_data.vertices[i], f);
+    printv(vertex(i), f);
     if (_data.vertexNormals != nullptr)
     {
       fputc('/', f);
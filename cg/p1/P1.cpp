@@ -16,14 +16,14 @@ namespace cg
 inline Primitive*
     makeBoxMesh()
 {
-    const vec4f p1{ -0.5, -0.5, -0.5, 1 };
-    const vec4f p2{ +0.5, -0.5, -0.5, 1 };
-    const vec4f p3{ +0.5, +0.5, -0.5, 1 };
-    const vec4f p4{ -0.5, +0.5, -0.5, 1 };
-    const vec4f p5{ -0.5, -0.5, +0.5, 1 };
-    const vec4f p6{ +0.5, -0.5, +0.5, 1 };
-    const vec4f p7{ +0.5, +0.5, +0.5, 1 };
-    const vec4f p8{ -0.5, +0.5, +0.5, 1 };
+    constexpr vec4f p1{ -0.5, -0.5, -0.5, 1 };
+    constexpr vec4f p2{ +0.5, -0.5, -0.5, 1 };
+    constexpr vec4f p3{ +0.5, +0.5, -0.5, 1 };
+    constexpr vec4f p4{ -0.5, +0.5, -0.5, 1 };
+    constexpr vec4f p5{ -0.5, -0.5, +0.5, 1 };
+    constexpr vec4f p6{ +0.5, -0.5, +0.5, 1 };
+    constexpr vec4f p7{ +0.5, +0.5, +0.5, 1 };
+    constexpr vec4f p8{ -0.5, +0.5, +0.5, 1 };
     const Color c1{ Color::black };
     const Color c2{ Color::red };
     const Color c3{ Color::yellow };
@@ -34,7 +34,7 @@ inline Primitive*
     const Color c8{ Color::white };
 
     // Box vertices
-    static const vec4f v[]
+    static constexpr vec4f v[]
     {
         p1, p5, p8, p4, // x = -0.5
         p2, p3, p7, p6, // x = +0.5
@@ -32,7 +32,14 @@
 
 #include "Assets.h"
 #include "graphics/Application.h"
+#include "graphics/GLMesh.h"
+#include "utils/MeshCache.h"
+#include "utils/MeshOptimizer.h"
+#include "utils/MeshSimplifier.h"
+#include <atomic>
 #include <filesystem>
+#include <thread>
+#include <vector>
 
 namespace cg
 { // begin namespace cg
@@ -44,11 +51,87 @@ namespace fs = std::experimental::filesystem;
 namespace fs = std::filesystem;
 #endif
 
+namespace internal
+{ // begin namespace internal
+
+// Maps the binary cache of the mesh, if it is up to date; otherwise,
+// reads the mesh, optimizes it for rendering, builds its levels of
+// detail and meshlets, and writes its cache for the next time. The
+// levels of detail and meshlets are stored in the cache, thus they
+// are built only when the cache is (re)written. If cancelled is set
+// while the mesh is processed, the mesh is discarded (and no cache is
+// written) before the next costly step
+TriangleMesh*
+readMesh(const std::string& name,
+  const MeshReader::ProgressCallback& progress = nullptr,
+  const std::atomic<bool>* cancelled = nullptr)
+{
+  auto filename = Application::assetFilePath(("meshes/" + name).c_str());
+  auto cacheFilename = filename + MeshCache::extension;
+  auto m = MeshCache::read(cacheFilename.c_str(), filename.c_str());
+
+  if (m != nullptr)
+    return m;
+  m = MeshReader::read(filename.c_str(), progress);
+  if (m == nullptr)
+    return nullptr;
+
+  auto isCancelled = [cancelled, &m]()
+  {
+    if (cancelled == nullptr || !*cancelled)
+      return false;
+    delete m;
+    m = nullptr;
+    return true;
+  };
+
+  MeshOptimizer::optimize(*m);
+  if (m->data().numberOfTriangles >= Assets::minLODTriangles
+    && !Assets::lodRatios().empty())
+  {
+    if (isCancelled())
+      return nullptr;
+
+    auto statistics = MeshSimplifier::buildLODs(*m, Assets::lodRatios());
+
+    for (const auto& s : statistics)
+      s.print(name.c_str());
+  }
+  if (m->data().numberOfTriangles >= Assets::minMeshletTriangles)
+  {
+    if (isCancelled())
+      return nullptr;
+    Meshlets::build(*m);
+  }
+  if (isCancelled())
+    return nullptr;
+  MeshCache::write(*m, cacheFilename.c_str(), filename.c_str());
+  return m;
+}
+
+} // end namespace internal
+
+
 /////////////////////////////////////////////////////////////////////
 //
 // Assets implementation
 // ======
+struct Assets::MeshLoad
+{
+  std::string name;
+  std::thread thread;
+  std::atomic<float> progress{0};
+  std::atomic<bool> cancelled{false};
+  std::atomic<bool> finished{false};
+  TriangleMesh* mesh{};
+  std::vector<MeshLoadCallback> callbacks;
+
+}; // Assets::MeshLoad
+
 MeshMap Assets::_meshes;
+std::list<Assets::MeshLoad> Assets::_loads;
+std::vector<float> Assets::_lodRatios{0.5f, 0.25f, 0.125f, 0.0625f};
+bool Assets::_quantizeMeshes{true};
 
 void
 Assets::initialize()
@@ -60,7 +143,8 @@ Assets::initialize()
     auto p = fs::directory_iterator(meshPath);
 
     for (auto e = fs::directory_iterator(); p != e; ++p)
-      if (fs::is_regular_file(p->status()))
+      if (fs::is_regular_file(p->status())
+        && MeshReader::isSupported(p->path().string().c_str()))
         _meshes[p->path().filename().string()] = nullptr;
   }
 }
@@ -73,14 +157,114 @@ Assets::loadMesh(MeshMapIterator mit)
 
   TriangleMesh* m{mit->second};
 
-  if (m == nullptr)
+  if (m != nullptr)
+    return m;
+  // If the mesh is being loaded, wait for its worker thread rather than
+  // reading the file (and writing its cache) once more
+  for (auto load = _loads.begin(); load != _loads.end(); ++load)
+    if (load->name == mit->first)
+    {
+      m = finishLoad(*load);
+      _loads.erase(load);
+      return m;
+    }
+  if ((m = internal::readMesh(mit->first)) != nullptr)
   {
-    auto filename = "meshes/" + mit->first;
-
-    m = Application::loadMesh(filename.c_str());
     _meshes[mit->first] = m;
+    glMesh(m, _quantizeMeshes);
+  }
+  return m;
+}
+
+void
+Assets::loadMeshAsync(MeshMapIterator mit, const MeshLoadCallback& done)
+{
+  if (mit == _meshes.end())
+    return;
+  if (mit->second != nullptr)
+  {
+    if (done)
+      done(mit->second);
+    return;
+  }
+  for (auto& load : _loads)
+    if (load.name == mit->first)
+    {
+      if (done)
+        load.callbacks.push_back(done);
+      return;
+    }
+
+  auto& load = _loads.emplace_back();
+
+  load.name = mit->first;
+  if (done)
+    load.callbacks.push_back(done);
+  load.thread = std::thread{[&load]()
+  {
+    load.mesh = internal::readMesh(load.name,
+      [&load](const MeshReader::Progress& p)
+      {
+        load.progress = p.fraction();
+        return !load.cancelled;
+      },
+      &load.cancelled);
+    load.finished = true;
+  }};
+}
+
+float
+Assets::loadProgress(MeshMapIterator mit)
+{
+  for (const auto& load : _loads)
+    if (load.name == mit->first)
+      return load.progress;
+  return -1;
+}
+
+void
+Assets::update()
+{
+  for (auto load = _loads.begin(); load != _loads.end();)
+  {
+    if (!load->finished)
+    {
+      ++load;
+      continue;
+    }
+    finishLoad(*load);
+    load = _loads.erase(load);
   }
+}
+
+TriangleMesh*
+Assets::finishLoad(MeshLoad& load)
+{
+  load.thread.join();
+
+  auto m = load.mesh;
+
+  if (m != nullptr)
+  {
+    _meshes[load.name] = m;
+    glMesh(m, _quantizeMeshes);
+  }
+  for (auto& done : load.callbacks)
+    done(m);
   return m;
 }
 
+void
+Assets::terminate()
+{
+  for (auto& load : _loads)
+    load.cancelled = true;
+  for (auto& load : _loads)
+  {
+    load.thread.join();
+    delete load.mesh;
+  }
+  _loads.clear();
+}
+
 } // end namespace cg
@@ -34,8 +34,10 @@
 #define __Assets_h
 
 #include "utils/MeshReader.h"
+#include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace cg
 { // begin namespace cg
@@ -43,6 +45,7 @@ namespace cg
 using MeshRef = Reference<TriangleMesh>;
 using MeshMap = std::map<std::string, MeshRef>;
 using MeshMapIterator = typename MeshMap::const_iterator;
+using MeshLoadCallback = std::function<void(TriangleMesh*)>;
 
 
 /////////////////////////////////////////////////////////////////////
@@ -59,10 +62,66 @@ public:
     return _meshes;
   }
 
+  /// Minimum number of triangles of a mesh with levels of detail.
+  static constexpr int minLODTriangles = 4096;
+
+  /// Triangle ratios of the levels of detail built for the meshes with
+  /// at least minLODTriangles triangles when they are loaded (none if
+  /// empty). Must not be changed while meshes are being loaded. The
+  /// levels of detail are stored in the mesh caches, so new ratios only
+  /// apply to the meshes whose caches are rebuilt.
+  static std::vector<float>& lodRatios()
+  {
+    return _lodRatios;
+  }
+
+  /// Whether the GL meshes of the loaded meshes with at least
+  /// GLMesh::minQuantizedVertices vertices have quantized vertex
+  /// attributes (see glMesh()). Only applies to the meshes loaded after
+  /// it is changed.
+  static bool& quantizeMeshes()
+  {
+    return _quantizeMeshes;
+  }
+
+  /// Minimum number of triangles of a mesh partitioned into meshlets
+  /// for culling when it is loaded.
+  static constexpr int minMeshletTriangles = 4096;
+
+  /// Reads the mesh of mit, unless it is loaded. If the mesh is being
+  /// loaded by loadMeshAsync(), waits for the load to finish instead.
+  /// Creates the GL mesh of the mesh, thus must be called from the
+  /// thread of the GL context.
   static TriangleMesh* loadMesh(MeshMapIterator mit);
 
+  /// Starts reading the mesh of mit on a worker thread, unless it is
+  /// loaded or being loaded. When the mesh is loaded, update() invokes
+  /// done with the mesh, or with nullptr if the mesh cannot be read.
+  static void loadMeshAsync(MeshMapIterator mit,
+    const MeshLoadCallback& done = nullptr);
+
+  /// Returns the fraction of the mesh of mit read so far, or a negative
+  /// value if the mesh is not being loaded.
+  static float loadProgress(MeshMapIterator mit);
+
+  /// Publishes the meshes read by the worker threads: creates their GL
+  /// meshes and invokes the callbacks passed to loadMeshAsync(). Must be
+  /// called once a frame from the thread of the GL context.
+  static void update();
+
+  /// Cancels the pending loads and waits for their worker threads.
+  static void terminate();
+
 private:
+  struct MeshLoad;
+
   static MeshMap _meshes;
+  static std::list<MeshLoad> _loads;
+  static std::vector<float> _lodRatios;
+  static bool _quantizeMeshes;
+
+  // Joins the worker thread of load and publishes its mesh
+  static TriangleMesh* finishLoad(MeshLoad& load);
 
 }; // Assets
 
@@ -120,6 +120,17 @@ void
     }
 }
 
+float
+    Camera::heightAt(const vec3f& p) const
+{
+    if (_projectionType == Parallel)
+        return _height;
+
+    auto z = -worldToCameraMatrix().transform3x4(p).z;
+
+    return 2 * std::max(z, _F) * tan(math::toRadians(_viewAngle * 0.5f));
+}
+
 inline mat4f
     lookAt(const vec3f& p, const vec3f& u, const vec3f& v, const vec3f& n)
 {
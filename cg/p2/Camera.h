@@ -83,6 +83,10 @@ public:
   mat4f cameraToWorldMatrix() const;
   mat4f projectionMatrix() const;
 
+  /// Returns the height of the view volume at the depth of the point p
+  /// (in world coordinates).
+  float heightAt(const vec3f& p) const;
+
   void reset(float aspect = 1);
 
   static Camera* current()
@@ -79,22 +79,33 @@ GLRenderer::render()
 inline void
 GLRenderer::drawPrimitive(Primitive& p)
 {
-    auto m = glMesh(p.mesh());
+    auto mesh = p.meshLOD(*_camera, _H);
+    auto m = glMesh(mesh);
 
     if (nullptr == m)
         return;
 
     auto t = p.transform();
-    auto normalMatrix = mat3f{ t->worldToLocalMatrix() }.transposed();
 
-    _program.setUniformMat4("transform", t->localToWorldMatrix());
-    _program.setUniformMat3("normalMatrix", normalMatrix);
+    _program.setUniformMat4("transform",
+        t->localToWorldMatrix() * m->positionMatrix());
+    _program.setUniformMat3("normalMatrix", t->normalMatrix());
     _program.setUniformVec4("color", p.color);
     _program.setUniform("flatMode", (int)0);
     m->bind();
 
     glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-    glDrawElements(GL_TRIANGLES, m->vertexCount(), GL_UNSIGNED_INT, 0);
+    // Back faces are drawn, thus the meshlets are culled against the
+    // view volume only
+    if (auto meshlets = mesh->meshlets.get())
+    {
+        _visibleMeshlets.clear();
+        meshlets->cull(vpMatrix(_camera) * t->localToWorldMatrix(),
+            _visibleMeshlets);
+        drawMeshlets(*m, *meshlets, _visibleMeshlets);
+    }
+    else
+        glDrawElements(GL_TRIANGLES, m->vertexCount(), m->indexType(), 0);
 }
 
 } // end namespace cg
@@ -61,6 +61,7 @@ public:
 
 private:
     GLSL::Program _program;
+    std::vector<int> _visibleMeshlets;
 
     void drawPrimitive(Primitive&);
 
@@ -43,6 +43,20 @@ makePrimitive(MeshMapIterator mit)
     return new Primitive{ mit->second, mit->first };
 }
 
+// Sets the mesh of mit to primitive as soon as it is loaded
+inline void
+setMeshAsync(Primitive& primitive, MeshMapIterator mit)
+{
+    Reference<Primitive> p{ &primitive };
+    auto meshName = mit->first;
+
+    Assets::loadMeshAsync(mit, [p, meshName](TriangleMesh* mesh)
+    {
+        if (mesh != nullptr)
+            p->setMesh(mesh, meshName);
+    });
+}
+
 inline void
 P2::buildScene()
 {
@@ -125,6 +139,7 @@ P2::initialize()
 void
 P2::terminate()
 {
+    Assets::terminate();
     glDeleteFramebuffers(1, &_fbo);
     glDeleteTextures(2, _tex);
 }
@@ -405,7 +420,7 @@ P2::inspectPrimitive(Primitive& primitive)
         if (auto * payload = ImGui::AcceptDragDropPayload("PrimitiveMesh"))
         {
             auto mit = *(MeshMapIterator*)payload->Data;
-            primitive.setMesh(mit->second, mit->first);
+            setMeshAsync(primitive, mit);
         }
         ImGui::EndDragDropTarget();
     }
@@ -420,7 +435,7 @@ P2::inspectPrimitive(Primitive& primitive)
         {
             for (auto mit = meshes.begin(); mit != meshes.end(); ++mit)
                 if (ImGui::Selectable(mit->first.c_str()))
-                    primitive.setMesh(Assets::loadMesh(mit), mit->first);
+                    setMeshAsync(primitive, mit);
             ImGui::Separator();
         }
         for (auto mit = _defaultMeshes.begin(); mit != _defaultMeshes.end(); ++mit)
@@ -644,9 +659,14 @@ P2::assetsWindow()
             auto selected = false;
 
             ImGui::Selectable(meshName, &selected);
+            if (auto progress = Assets::loadProgress(mit); progress >= 0)
+            {
+                ImGui::SameLine();
+                ImGui::ProgressBar(progress);
+            }
             if (ImGui::BeginDragDropSource())
             {
-                Assets::loadMesh(mit);
+                Assets::loadMeshAsync(mit);
                 ImGui::Text(meshName);
                 ImGui::SetDragDropPayload("PrimitiveMesh", &mit, sizeof(mit));
                 ImGui::EndDragDropSource();
@@ -775,6 +795,7 @@ P2::mainMenu()
 void
 P2::gui()
 {
+    Assets::update();
     mainMenu();
     hierarchyWindow();
     inspectorWindow();
@@ -788,35 +809,55 @@ P2::gui()
 }
 
 inline void
-drawMesh(GLMesh* mesh, GLuint mode)
+drawMesh(GLMesh* mesh,
+    GLuint mode,
+    const Meshlets* meshlets,
+    const std::vector<int>& visible)
 {
     glPolygonMode(GL_FRONT_AND_BACK, mode);
-    glDrawElements(GL_TRIANGLES, mesh->vertexCount(), GL_UNSIGNED_INT, 0);
+    if (meshlets != nullptr)
+        drawMeshlets(*mesh, *meshlets, visible);
+    else
+        glDrawElements(GL_TRIANGLES, mesh->vertexCount(), mesh->indexType(), 0);
 }
 
 inline void
 P2::drawPrimitive(Primitive& primitive, bool wireframe)
 {
-    auto m = glMesh(primitive.mesh());
+    auto ec = _editor->camera();
+    auto mesh = primitive.meshLOD(*ec, height());
+    auto m = glMesh(mesh);
 
     if (nullptr == m)
         return;
 
     auto t = primitive.transform();
-    auto normalMatrix = mat3f{ t->worldToLocalMatrix() }.transposed();
 
-    _program.setUniformMat4("transform", t->localToWorldMatrix());
-    _program.setUniformMat3("normalMatrix", normalMatrix);
+    _program.setUniformMat4("transform",
+        t->localToWorldMatrix() * m->positionMatrix());
+    _program.setUniformMat3("normalMatrix", t->normalMatrix());
     _program.setUniformVec4("color", primitive.color);
     _program.setUniform("flatMode", (int)0);
     m->bind();
-    drawMesh(m, GL_FILL);
+
+    // Draw only the meshlets in the view, if any. Back faces are drawn
+    // (and so is the back of the wireframe), thus meshlets facing away
+    // from the eye are not culled
+    const Meshlets* meshlets = mesh->meshlets;
+
+    if (meshlets != nullptr)
+    {
+        _visibleMeshlets.clear();
+        meshlets->cull(vpMatrix(ec) * t->localToWorldMatrix(),
+            _visibleMeshlets);
+    }
+    drawMesh(m, GL_FILL, meshlets, _visibleMeshlets);
 
     if (wireframe)
     {
         _program.setUniformVec4("color", _selectedWireframeColor);
         _program.setUniform("flatMode", (int)1);
-        drawMesh(m, GL_LINE);
+        drawMesh(m, GL_LINE, meshlets, _visibleMeshlets);
     }
 }
 
@@ -881,9 +922,7 @@ P2::drawCamera(Camera& cam)
        vec3f(vec2f(r, t) * h_far, -z_far),
     };
 
-    // XXX It should be vectorized
-    for (auto& e : p)
-        e = to_world.transform3x4(e);
+    to_world.transform3x4(p, p, 8);
 
 	_editor->drawLine(p[0], p[1]);
     _editor->drawLine(p[1], p[3]);
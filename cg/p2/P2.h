@@ -61,6 +61,7 @@ private:
   Reference<GLRenderer> _renderer;
   SceneNode* _current{};
   Color _selectedWireframeColor{255, 102, 0};
+  std::vector<int> _visibleMeshlets;
   Flags<MoveBits> _moveFlags{};
   Flags<DragBits> _dragFlags{};
   int _pivotX;
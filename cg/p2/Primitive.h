@@ -33,6 +33,7 @@
 #ifndef __Primitive_h
 #define __Primitive_h
 
+#include "Camera.h"
 #include "Component.h"
 #include "graphics/GLMesh.h"
 
@@ -67,6 +68,19 @@ public:
     return _meshName.c_str();
   }
 
+  /// Returns the level of detail of the mesh to draw in a viewport of
+  /// height pixels, as seen by camera.
+  TriangleMesh* meshLOD(const Camera& camera, int height)
+  {
+    if (_mesh == nullptr || _mesh->lods.empty())
+      return _mesh;
+
+    const Bounds3f b{_mesh->bounds(), transform()->localToWorldMatrix()};
+    const auto size = b.diagonalLength() / camera.heightAt(b.center());
+
+    return _mesh->lod(size * height);
+  }
+
   void setMesh(TriangleMesh* mesh, const std::string& meshName)
   {
     _mesh = mesh;
@@ -89,33 +89,46 @@ Transform::Transform() :
     _rotation = _localRotation;
     _lossyScale = _localScale;
     _inverseMatrix = _matrix;
+    _normalMatrix = mat3f{ 1.0f };
 }
 
-inline mat4f
-    Transform::localMatrix() const
+// Updates the local to world, world to local and normal matrices from
+// the local TRS of this transform and the matrices of its parent. With
+// M = TRS, the normal matrix of M is RS^-1 and the inverse of M is
+// [(RS^-1)^T; -(RS^-1)^T * position], so the rotation matrix is built
+// from the quaternion once and nothing is inverted but the scale
+inline void
+    Transform::updateMatrices()
 {
-    return mat4f::TRS(_localPosition, _localRotation, _localScale);
-}
-
-inline mat4f
-    Transform::inverseLocalMatrix() const
-{
-    mat3f r{ _localRotation };
-
-    r[0] *= math::inverse(_localScale[0]);
-    r[1] *= math::inverse(_localScale[1]);
-    r[2] *= math::inverse(_localScale[2]);
-
-    mat4f m;
-
-    m[0].set(r[0][0], r[1][0], r[2][0]);
-    m[1].set(r[0][1], r[1][1], r[2][1]);
-    m[2].set(r[0][2], r[1][2], r[2][2]);
-    m[3][0] = -(r[0].dot(_localPosition));
-    m[3][1] = -(r[1].dot(_localPosition));
-    m[3][2] = -(r[2].dot(_localPosition));
-    m[3][3] = 1.0f;
-    return m;
+    const mat3f r{ _localRotation };
+    mat4f m{ r, _localPosition };
+    mat3f n;
+    mat4f inv;
+
+    for (int j = 0; j < 3; ++j)
+    {
+        m[j] *= _localScale[j];
+        n[j] = r[j] * math::inverse(_localScale[j]);
+    }
+    inv[0].set(n[0][0], n[1][0], n[2][0]);
+    inv[1].set(n[0][1], n[1][1], n[2][1]);
+    inv[2].set(n[0][2], n[1][2], n[2][2]);
+    inv[3].set(-(n[0].dot(_localPosition)),
+        -(n[1].dot(_localPosition)),
+        -(n[2].dot(_localPosition)),
+        1.0f);
+    if (auto p = parent())
+    {
+        _matrix = p->_matrix * m;
+        _inverseMatrix = inv * p->_inverseMatrix;
+        _normalMatrix = p->_normalMatrix * n;
+    }
+    else
+    {
+        _matrix = m;
+        _inverseMatrix = inv;
+        _normalMatrix = n;
+    }
 }
 
 void
@@ -164,11 +177,10 @@ void
 {
     auto p = parent();
 
-    _matrix = p ? p->_matrix * localMatrix() : localMatrix();
+    updateMatrices();
     _position = translation(_matrix);
     _rotation = p ? p->_rotation * _localRotation : _localRotation;
     _lossyScale = scale(_rotation, _matrix);
-    _inverseMatrix = p ? inverseLocalMatrix() * p->_inverseMatrix : inverseLocalMatrix();
     
     // Update the transform of all scene object's children
     for (auto it = sceneObject()->iter_hierarchy_objects(false); it; it.next())
@@ -187,9 +199,8 @@ void
     _localRotation = p ? p->_rotation.inverse() * _rotation : _rotation;
     _localEulerAngles = _localRotation.eulerAngles();
     _localScale = scale(_localRotation, m);
-    _matrix = p ? p->_matrix * localMatrix() : localMatrix();
+    updateMatrices();
     _lossyScale = scale(_rotation, _matrix);
-    _inverseMatrix = p ? inverseLocalMatrix() * p->_inverseMatrix : inverseLocalMatrix();
 
     // Update the transform of all scene object's children.
     for (auto it = sceneObject()->iter_hierarchy_objects(false); it; it.next())
@@ -202,6 +202,14 @@ public:
         return _inverseMatrix;
     }
 
+    /// Returns the matrix transforming normals from local space to
+    /// world space (the transposed inverse of the 3x3 part of the local
+    /// to world _matrix).
+    const mat3f& normalMatrix() const
+    {
+        return _normalMatrix;
+    }
+
     /// Transforms \c p from local space to world space.
     vec3f transform(const vec3f& p) const
     {
@@ -247,9 +255,9 @@ private:
     vec3f _lossyScale;
     mat4f _matrix;
     mat4f _inverseMatrix;
+    mat3f _normalMatrix;
 
-    mat4f localMatrix() const;
-    mat4f inverseLocalMatrix() const;
+    void updateMatrices();
 
     void rotate(const quatf&, Space = Space::Local);
     void update();